@@ -0,0 +1,127 @@
+#ifndef BLOOM_FILTER_H
+#define BLOOM_FILTER_H
+
+#ifndef nullptr
+#define nullptr 0
+#endif
+
+#include "Exceptions.h"
+
+//Blocked Bloom filter: every key maps to a single 512-bit block (one cache line)
+//and all of its bits are set and tested inside that block, so a query touches one line
+class Bloom_filter {
+	private:
+		static const int WORDS_PER_BLOCK = 8;	//8 x 64 bits = 64 bytes
+		static const int PROBES = 6;			//Bits set per key
+
+		long long block_count;
+		long long block_mask;
+		unsigned long long *blocks;
+
+	public:
+		Bloom_filter( long long = 1 );
+		~Bloom_filter();
+		Bloom_filter( Bloom_filter const & );
+		Bloom_filter &operator=( Bloom_filter const & );
+
+		long long blocks_used() const;
+		bool may_contain( unsigned long long ) const;
+
+		void add( unsigned long long );
+		void clear();
+};
+
+//Constructor
+//Allocates enough blocks for roughly 8 bits per expected key, rounded up to a power of two
+inline Bloom_filter::Bloom_filter( long long expected_keys ):
+block_count( 1 ),
+block_mask( 0 ),
+blocks( nullptr ) {
+	if ( expected_keys < 0 ) {
+		throw illegal_argument();
+	}
+
+	while ( block_count*WORDS_PER_BLOCK*64 < 8*expected_keys ) {
+		block_count <<= 1;
+	}
+
+	block_mask = block_count - 1;
+	blocks = new unsigned long long[block_count*WORDS_PER_BLOCK];
+	clear();
+}
+
+//Destructor
+inline Bloom_filter::~Bloom_filter() {
+	delete[] blocks;
+}
+
+inline Bloom_filter::Bloom_filter( Bloom_filter const &other ):
+block_count( other.block_count ),
+block_mask( other.block_mask ),
+blocks( new unsigned long long[other.block_count*WORDS_PER_BLOCK] ) {
+	for ( long long i = 0; i < block_count*WORDS_PER_BLOCK; ++i ) {
+		blocks[i] = other.blocks[i];
+	}
+}
+
+inline Bloom_filter &Bloom_filter::operator=( Bloom_filter const &rhs ) {
+	if ( this != &rhs ) {
+		unsigned long long *copy = new unsigned long long[rhs.block_count*WORDS_PER_BLOCK];
+
+		for ( long long i = 0; i < rhs.block_count*WORDS_PER_BLOCK; ++i ) {
+			copy[i] = rhs.blocks[i];
+		}
+
+		delete[] blocks;
+		blocks = copy;
+		block_count = rhs.block_count;
+		block_mask = rhs.block_mask;
+	}
+
+	return *this;
+}
+
+//Accessors
+inline long long Bloom_filter::blocks_used() const {
+	return block_count;
+}
+
+//The high 40 bits of the hash select the block; each probe then takes the next
+//9 bits of a remixed hash as a bit position (0..511) inside that block
+inline bool Bloom_filter::may_contain( unsigned long long h ) const {
+	unsigned long long const *block = blocks + (static_cast<long long>(h >> 24) & block_mask)*WORDS_PER_BLOCK;
+	unsigned long long bits = (h*0x9E3779B97F4A7C15ULL) >> 10;
+
+	for ( int i = 0; i < PROBES; ++i ) {
+		int position = static_cast<int>(bits & 511);
+
+		if ( (block[position >> 6] & (1ULL << (position & 63))) == 0 ) {
+			return false;
+		}
+
+		bits >>= 9;
+	}
+
+	return true;
+}
+
+//Mutators
+inline void Bloom_filter::add( unsigned long long h ) {
+	unsigned long long *block = blocks + (static_cast<long long>(h >> 24) & block_mask)*WORDS_PER_BLOCK;
+	unsigned long long bits = (h*0x9E3779B97F4A7C15ULL) >> 10;
+
+	for ( int i = 0; i < PROBES; ++i ) {
+		int position = static_cast<int>(bits & 511);
+
+		block[position >> 6] |= 1ULL << (position & 63);
+		bits >>= 9;
+	}
+}
+
+inline void Bloom_filter::clear() {
+	for ( long long i = 0; i < block_count*WORDS_PER_BLOCK; ++i ) {
+		blocks[i] = 0;
+	}
+}
+
+#endif
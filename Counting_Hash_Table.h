@@ -0,0 +1,285 @@
+#ifndef COUNTING_HASH_TABLE_H
+#define COUNTING_HASH_TABLE_H
+
+#ifndef nullptr
+#define nullptr 0
+#endif
+
+#include "Exceptions.h"
+#include "Hash_Table.h"
+
+//Multiset variant of Hash_table: each bin stores a key together with the number of
+//times it has been inserted, so an event costs one probe sequence.
+//The bins are those of a Hash_table of (key, count) entries that hash and compare by their
+//key alone, so the hashing, probing, storage and 64-bit sizes are the ones of Hash_table
+template <typename Type>
+class Counting_hash_table {
+	private:
+		struct entry_t {
+			Type key;
+			long long frequency;
+
+			operator long long() const {
+				return static_cast<long long>( key );
+			}
+
+			bool operator==( entry_t const &other ) const {
+				return key == other.key;
+			}
+		};
+
+		Hash_table<entry_t> table;
+		long long events;			//Sum of all frequencies
+
+		static entry_t entry( Type const &, long long );
+		void print( std::ostream & ) const;
+
+	public:
+		Counting_hash_table( int = 5 );
+		bin_index_t size() const;
+		long long total() const;
+		bin_index_t capacity() const;
+		double load_factor() const;
+		bool empty() const;
+		bool member( Type const & ) const;
+		long long count( Type const & ) const;
+		int top_k( int, Type *, long long * ) const;
+
+		long long insert( Type const & );
+		long long erase( Type const & );
+		void clear();
+
+	// Friends
+
+	template <typename T>
+	friend std::ostream &operator<<( std::ostream &, Counting_hash_table<T> const & );
+
+	private:
+		Counting_hash_table( Counting_hash_table const & );
+		Counting_hash_table &operator=( Counting_hash_table const & );
+};
+
+//Constructor
+template <typename Type>
+Counting_hash_table<Type>::Counting_hash_table( int m ):
+table( m ),
+events( 0 ) {
+	//empty constructor
+}
+
+//An entry for obj; lookups only compare the key, so the frequency does not matter to them
+template <typename Type>
+typename Counting_hash_table<Type>::entry_t Counting_hash_table<Type>::entry( Type const &obj, long long frequency ) {
+	entry_t e = { obj, frequency };
+
+	return e;
+}
+
+//Accessors
+template <typename Type>
+bin_index_t Counting_hash_table<Type>::size() const {
+	return this->table.size();			//Returns the number of distinct keys
+}
+
+template <typename Type>
+long long Counting_hash_table<Type>::total() const {
+	return this->events;				//Returns the number of insertions not yet erased
+}
+
+template <typename Type>
+bin_index_t Counting_hash_table<Type>::capacity() const {
+	return this->table.capacity();
+}
+
+template <typename Type>
+double Counting_hash_table<Type>::load_factor() const {
+	return this->table.load_factor();
+}
+
+template <typename Type>
+bool Counting_hash_table<Type>::empty() const {
+	return this->table.empty();
+}
+
+template <typename Type>
+bool Counting_hash_table<Type>::member(Type const &obj) const {
+	return(this->table.locate(entry(obj, 0)) >= 0);
+}
+
+template <typename Type>
+long long Counting_hash_table<Type>::count(Type const &obj) const {
+	bin_index_t probe = this->table.locate(entry(obj, 0));
+	return(probe < 0 ? 0 : this->table.array[probe].frequency);
+}
+
+//Writes the (at most) k most frequent keys into keys[] and their counts into counts[],
+//most frequent first, and returns how many were written.
+//A min-heap of size k is kept over one pass of the bins, so the cost is O(capacity log k)
+template <typename Type>
+int Counting_hash_table<Type>::top_k(int k, Type *keys, long long *counts) const {
+	if(k < 0)
+	{
+		throw illegal_argument();
+	}
+	if(k > this->table.size())
+	{
+		k = static_cast<int>(this->table.size());
+	}
+	if(k == 0)
+	{
+		return 0;
+	}
+
+	entry_t const *array = this->table.array;
+	bin_index_t *heap = new bin_index_t[k];		//Bin numbers, ordered by frequency with the smallest on top
+	int heap_size = 0;
+
+	for(bin_index_t i = 0; i < this->table.array_size; i++)
+	{
+		if(this->table.occupied[i] != OCCUPIED)
+		{
+			continue;
+		}
+		int position;
+		if(heap_size < k)
+		{
+			//Sift the new bin up from the bottom
+			position = heap_size++;
+			while(position > 0 && array[heap[(position - 1) / 2]].frequency > array[i].frequency)
+			{
+				heap[position] = heap[(position - 1) / 2];
+				position = (position - 1) / 2;
+			}
+			heap[position] = i;
+		}
+		else if(array[i].frequency > array[heap[0]].frequency)
+		{
+			//Replace the smallest and sift it down
+			position = 0;
+			while(true)
+			{
+				int child = 2*position + 1;
+				if(child >= heap_size)
+				{
+					break;
+				}
+				if(child + 1 < heap_size && array[heap[child + 1]].frequency < array[heap[child]].frequency)
+				{
+					child++;
+				}
+				if(array[heap[child]].frequency >= array[i].frequency)
+				{
+					break;
+				}
+				heap[position] = heap[child];
+				position = child;
+			}
+			heap[position] = i;
+		}
+	}
+
+	//Pop the heap from the back so the most frequent key ends up first
+	for(int n = heap_size - 1; n >= 0; n--)
+	{
+		keys[n] = array[heap[0]].key;
+		counts[n] = array[heap[0]].frequency;
+
+		bin_index_t last = heap[n];
+		int position = 0;
+		while(true)
+		{
+			int child = 2*position + 1;
+			if(child >= n)
+			{
+				break;
+			}
+			if(child + 1 < n && array[heap[child + 1]].frequency < array[heap[child]].frequency)
+			{
+				child++;
+			}
+			if(array[heap[child]].frequency >= array[last].frequency)
+			{
+				break;
+			}
+			heap[position] = heap[child];
+			position = child;
+		}
+		heap[position] = last;
+	}
+
+	delete[] heap;
+	return heap_size;
+}
+
+//Mutators
+//Increments the count of obj, adding it with a count of one if it is new, and returns the new count.
+//A key already present costs one probe sequence; a new one is placed by Hash_table, which reuses
+//the first erased bin on its probe sequence
+template <typename Type>
+long long Counting_hash_table<Type>::insert(Type const &obj) {
+	bin_index_t probe = this->table.locate(entry(obj, 0));
+
+	if(probe >= 0)
+	{
+		this->events++;
+		return ++this->table.array[probe].frequency;
+	}
+
+	if(this->table.count >= this->table.array_size)
+	{
+		//Every bin holds another key
+		throw overflow();
+	}
+
+	this->table.insert_new(entry(obj, 1));
+	this->events++;
+	return 1;
+}
+
+//Decrements the count of obj and returns the new count; the key is removed when it reaches zero.
+//Returns -1 if obj is not in the table
+template <typename Type>
+long long Counting_hash_table<Type>::erase(Type const &obj) {
+	bin_index_t probe = this->table.locate(entry(obj, 0));
+	if(probe < 0)
+	{
+		return -1;
+	}
+	this->events--;
+	long long frequency = --this->table.array[probe].frequency;
+	if(frequency == 0)
+	{
+		this->table.erase_bin(probe);
+	}
+	return frequency;
+}
+
+template <typename Type>
+void Counting_hash_table<Type>::clear() {
+	this->table.clear();
+	this->events = 0;
+	return;
+}
+
+//Writes every bin: - if unoccupied, x if erased, key:count otherwise
+template <typename Type>
+void Counting_hash_table<Type>::print( std::ostream &out ) const {
+	for ( bin_index_t i = 0; i < table.array_size; ++i ) {
+		if ( table.occupied[i] == UNOCCUPIED ) {
+			out << "- ";
+		} else if ( table.occupied[i] == ERASED ) {
+			out << "x ";
+		} else {
+			out << table.array[i].key << ':' << table.array[i].frequency << ' ';
+		}
+	}
+}
+
+template <typename T>
+std::ostream &operator<<( std::ostream &out, Counting_hash_table<T> const &hash ) {
+	hash.print( out );
+
+	return out;
+}
+
+#endif
@@ -0,0 +1,225 @@
+#ifndef COUNTING_HASH_TABLE_TESTER_H
+#define COUNTING_HASH_TABLE_TESTER_H
+
+#ifndef nullptr
+#define nullptr 0
+#endif
+
+#include "Exceptions.h"
+#include "Test.h"
+#include "Counting_Hash_Table.h"
+
+#include <iostream>
+
+
+template <typename Type>
+class Counting_hash_table_tester:public test< Counting_hash_table<Type> > {
+	using test< Counting_hash_table<Type> >::object;
+	using test< Counting_hash_table<Type> >::command;
+
+	public:
+		Counting_hash_table_tester(Counting_hash_table<Type> *obj =
+0 ):test< Counting_hash_table<Type> >(obj){
+			//empty
+		}
+
+		void process();
+};
+
+template <typename Type>
+void Counting_hash_table_tester<Type>::process() {
+	if(command == "new"){
+		object = new Counting_hash_table<Type>();
+		std::cout << "Okay" << std::endl;
+	} else if(command == "new:"){
+		int n;
+		std::cin >> n;
+		object = new Counting_hash_table<Type>(n );
+		std::cout << "Okay" << std::endl;
+	} else if(command == "size"){
+		//Check if the number of distinct keys equals the next integer read
+
+		bin_index_t expected_size;
+
+		std::cin >> expected_size;
+
+		bin_index_t actual_size = object->size();
+
+		if(actual_size == expected_size){
+			std::cout << "Okay" << std::endl;
+		} else {
+			std::cout << ": Failed size(): expecting the value '" << expected_size << "' but got '" << actual_size << "'" << std::endl;
+		}
+	} else if(command == "total"){
+		//Check if the sum of all counts equals the next integer read
+
+		long long expected_total;
+
+		std::cin >> expected_total;
+
+		long long actual_total = object->total();
+
+		if(actual_total == expected_total){
+			std::cout << "Okay" << std::endl;
+		} else {
+			std::cout << ": Failed total(): expecting the value '" << expected_total << "' but got '" << actual_total << "'" << std::endl;
+		}
+	} else if(command == "capacity"){
+		//Check if the capacity equals the next integer read
+
+		bin_index_t expected_capacity;
+
+		std::cin >> expected_capacity;
+
+		bin_index_t actual_capacity = object->capacity();
+
+		if(actual_capacity == expected_capacity){
+			std::cout << "Okay" << std::endl;
+		} else {
+			std::cout << ": Failed capacity(): expecting the value '" << expected_capacity << "' but got '" << actual_capacity << "'" << std::endl;
+		}
+	} else if(command == "empty"){
+		//Check if the empty status equals the next Boolean read
+
+		bool expected_empty;
+
+		std::cin >> expected_empty;
+
+		bool actual_empty = object->empty();
+
+		if(actual_empty == expected_empty){
+			std::cout << "Okay" << std::endl;
+		} else {
+			std::cout << ": Failed empty(): expecting the value '" << expected_empty << "' but got '" << actual_empty << "'" << std::endl;
+		}
+	} else if(command == "member"){
+		//Check if the key is in the object
+
+		Type n;
+		bool expected_member;
+
+		std::cin >> n;
+		std::cin >> expected_member;
+
+		bool actual_member = object->member(n );
+
+		if(actual_member == expected_member){
+			std::cout << "Okay" << std::endl;
+		} else {
+			std::cout << ": Failed member(" << n << "): expecting the value '" << expected_member << "' but got '" << actual_member << "'" << std::endl;
+		}
+	} else if(command == "count"){
+		//Check the count of the key
+
+		Type n;
+		long long expected_count;
+
+		std::cin >> n;
+		std::cin >> expected_count;
+
+		long long actual_count = object->count(n );
+
+		if(actual_count == expected_count){
+			std::cout << "Okay" << std::endl;
+		} else {
+			std::cout << ": Failed count(" << n << "): expecting the value '" << expected_count << "' but got '" << actual_count << "'" << std::endl;
+		}
+	} else if(command == "insert"){
+		//Insert the key and check the new count returned
+
+		Type n;
+		long long expected_count;
+
+		std::cin >> n;
+		std::cin >> expected_count;
+
+		long long actual_count = object->insert(n );
+
+		if(actual_count == expected_count){
+			std::cout << "Okay" << std::endl;
+		} else {
+			std::cout << ": Failed insert(" << n << "): expecting the value '" << expected_count << "' but got '" << actual_count << "'" << std::endl;
+		}
+	} else if(command == "insert!"){
+		//Cannot insert a new key due to the table being full
+
+		Type n;
+
+		std::cin >> n;
+
+		try {
+			object->insert(n );
+			std::cout << "Failed insert(" << n << "): expecting to catch an exception but did not" << std::endl;
+		} catch(overflow){
+			std::cout << "Okay" << std::endl;
+		} catch (...) {
+			std::cout << "Failed insert(" << n << "): expecting an overflow exception but caught a different exception" << std::endl;
+		}
+	} else if(command == "erase"){
+		//Erase one occurrence of the key and check the new count returned (-1 if absent)
+
+		Type n;
+		long long expected_count;
+
+		std::cin >> n;
+		std::cin >> expected_count;
+
+		long long actual_count = object->erase(n );
+
+		if(actual_count == expected_count){
+			std::cout << "Okay" << std::endl;
+		} else {
+			std::cout << ": Failed erase(" << n << "): expecting the value '" << expected_count << "' but got '" << actual_count << "'" << std::endl;
+		}
+	} else if(command == "top_k"){
+		//Ask for the k most frequent keys; check how many are returned and their counts, most
+		//frequent first. Keys with equal counts may come in any order, so only the counts are
+		//read, and each key returned must have the count returned with it
+
+		int k;
+		int expected_found;
+
+		std::cin >> k;
+		std::cin >> expected_found;
+
+		long long *expected_counts = new long long[expected_found > 0 ? expected_found : 1];
+
+		for(int i = 0; i < expected_found; ++i){
+			std::cin >> expected_counts[i];
+		}
+
+		Type *keys = new Type[k > 0 ? k : 1];
+		long long *counts = new long long[k > 0 ? k : 1];
+
+		int actual_found = object->top_k(k, keys, counts );
+
+		if(actual_found != expected_found){
+			std::cout << ": Failed top_k(" << k << "): expecting '" << expected_found << "' keys but got '" << actual_found << "'" << std::endl;
+		} else {
+			int i = 0;
+
+			while(i < actual_found && counts[i] == expected_counts[i] && object->count(keys[i] ) == counts[i]){
+				++i;
+			}
+
+			if(i == actual_found){
+				std::cout << "Okay" << std::endl;
+			} else {
+				std::cout << ": Failed top_k(" << k << "): expecting key " << i << " to have the count '" << expected_counts[i] << "' but got the key '" << keys[i] << "' with '" << counts[i] << "'" << std::endl;
+			}
+		}
+
+		delete[] counts;
+		delete[] keys;
+		delete[] expected_counts;
+	} else if(command == "clear"){
+		object->clear();
+
+		std::cout << "Okay" << std::endl;
+	} else if(command == "cout"){
+		std::cout << *object << std::endl;
+	} else {
+		std::cout << command << ": Command not found." << std::endl;
+	}
+}
+#endif
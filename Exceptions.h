@@ -25,4 +25,8 @@ class out_of_range : public exception {
 	// emtpy class
 };
 
+class io_error : public exception {
+	// empty class
+};
+
 #endif
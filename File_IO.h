@@ -0,0 +1,56 @@
+#ifndef FILE_IO_H
+#define FILE_IO_H
+
+#include "Exceptions.h"
+
+#include <cerrno>
+#include <unistd.h>
+
+//Writes all n bytes, retrying short and interrupted writes. Throws io_error on failure
+inline void write_fully( int fd, void const *data, long long n ) {
+	char const *p = static_cast<char const *>( data );
+
+	while ( n > 0 ) {
+		ssize_t written = ::write( fd, p, n );
+
+		if ( written < 0 ) {
+			if ( errno == EINTR ) {
+				continue;
+			}
+
+			throw io_error();
+		}
+
+		p += written;
+		n -= written;
+	}
+}
+
+//Reads up to n bytes, stopping early only at the end of the file, and returns the number read.
+//Throws io_error on failure
+inline long long read_fully( int fd, void *data, long long n ) {
+	char *p = static_cast<char *>( data );
+	long long total = 0;
+
+	while ( total < n ) {
+		ssize_t got = ::read( fd, p + total, n - total );
+
+		if ( got < 0 ) {
+			if ( errno == EINTR ) {
+				continue;
+			}
+
+			throw io_error();
+		}
+
+		if ( got == 0 ) {
+			break;
+		}
+
+		total += got;
+	}
+
+	return total;
+}
+
+#endif
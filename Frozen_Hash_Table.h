@@ -0,0 +1,347 @@
+#ifndef FROZEN_HASH_TABLE_H
+#define FROZEN_HASH_TABLE_H
+
+#ifndef nullptr
+#define nullptr 0
+#endif
+
+#include "Exceptions.h"
+#include "Hash_Table.h"
+#include "Hash_Functions.h"
+
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+//Immutable copy of a Hash_table laid out with a minimal perfect hash (CHD: compress, hash
+//and displace). The n keys are stored densely in n slots. Each key hashes to one of about n/4
+//buckets, and every bucket has a pilot value, chosen when the table is built, that sends all of
+//its keys to distinct slots. A lookup is one hash, one pilot read and one key comparison.
+//Pilots are searched over n + n/16 + 1 slots rather than n, so even the last buckets placed
+//find free slots within a few dozen tries and the build takes linear time; as in PTHash, the
+//keys that land past slot n are sent to the slots below n left free, through a small remap table
+template <typename Type>
+class Frozen_hash_table {
+	private:
+		static const int KEYS_PER_BUCKET = 4;
+		static const int SLACK = 16;						//One spare slot per SLACK keys
+		static const unsigned int MAX_PILOT = 1u << 24;	//Pilots tried per bucket before reseeding
+
+		bin_index_t count;
+		bin_index_t slot_count;
+		bin_index_t bucket_count;
+		unsigned long long seed;
+		unsigned int *pilot;
+		bin_index_t *remap;
+		Type *keys;
+
+		unsigned long long hash( Type const & ) const;
+		bin_index_t slot( unsigned long long, unsigned int ) const;
+		bin_index_t position( unsigned long long ) const;
+		bool build( unsigned long long *, bool & );
+
+	public:
+		Frozen_hash_table( Hash_table<Type> const & );
+		~Frozen_hash_table();
+		bin_index_t size() const;
+		bool empty() const;
+		bool member( Type const & ) const;
+		bin_index_t memory_bytes() const;
+
+	private:
+		Frozen_hash_table( Frozen_hash_table const & );
+		Frozen_hash_table &operator=( Frozen_hash_table const & );
+};
+
+//Constructor
+//Copies the elements of table. Throws illegal_argument if two different elements of table
+//hash identically (same integer value for non-floating-point types), as no perfect hash exists then
+template <typename Type>
+Frozen_hash_table<Type>::Frozen_hash_table( Hash_table<Type> const &table ):
+count( 0 ),
+slot_count( 0 ),
+bucket_count( 0 ),
+seed( 0 ),
+pilot( nullptr ),
+remap( nullptr ),
+keys( nullptr ) {
+	//Gather the elements; the bins of a Hash_table are only valid where they are occupied,
+	//and in TTL mode the expired elements are left behind
+	Type const **elements = new Type const *[table.size() == 0 ? 1 : table.size()];
+
+	for ( bin_index_t i = 0; i < table.array_size; ++i ) {
+		if ( table.live( i ) ) {
+			elements[count++] = table.array + i;
+		}
+	}
+
+	slot_count = count + count/SLACK + 1;
+	bucket_count = (count + KEYS_PER_BUCKET - 1)/KEYS_PER_BUCKET;
+
+	if ( bucket_count == 0 ) {
+		bucket_count = 1;
+	}
+
+	pilot = new unsigned int[bucket_count];
+	remap = new bin_index_t[slot_count - count];
+	keys = static_cast<Type *>( ::operator new( (count == 0 ? 1 : count)*sizeof( Type ) ) );
+
+	//Reseed until every bucket finds a pilot; with about 4 keys per bucket this rarely repeats
+	unsigned long long *h = new unsigned long long[count == 0 ? 1 : count];
+	bool built = false;
+	bool duplicate = false;
+
+	for ( int attempt = 0; attempt < 16 && !built && !duplicate; ++attempt ) {
+		seed = splitmix64( 0x9E3779B97F4A7C15ULL*(attempt + 1) );
+
+		for ( bin_index_t i = 0; i < count; ++i ) {
+			h[i] = hash( *elements[i] );
+		}
+
+		built = build( h, duplicate );
+
+		if ( built ) {
+			//build() recorded the slot of element i in h[i]
+			for ( bin_index_t i = 0; i < count; ++i ) {
+				new ( keys + h[i] ) Type( *elements[i] );
+			}
+		}
+	}
+
+	delete[] h;
+	delete[] elements;
+
+	if ( !built ) {
+		delete[] remap;
+		delete[] pilot;
+		::operator delete( static_cast<void *>( keys ) );
+
+		if ( duplicate ) {
+			throw illegal_argument();
+		}
+
+		throw overflow();
+	}
+}
+
+//Destructor
+template <typename Type>
+Frozen_hash_table<Type>::~Frozen_hash_table() {
+	if ( !std::is_trivially_destructible<Type>::value ) {
+		for ( bin_index_t i = 0; i < count; ++i ) {
+			keys[i].~Type();
+		}
+	}
+
+	::operator delete( static_cast<void *>( keys ) );
+	delete[] remap;
+	delete[] pilot;
+}
+
+template <typename Type>
+unsigned long long Frozen_hash_table<Type>::hash( Type const &obj ) const {
+	return splitmix64( key_bits( obj ) ^ seed );
+}
+
+//Slot of a key with hash h in a bucket with pilot p
+template <typename Type>
+bin_index_t Frozen_hash_table<Type>::slot( unsigned long long h, unsigned int p ) const {
+	return static_cast<bin_index_t>( splitmix64( h ^ (p*0x9E3779B97F4A7C15ULL) ) % slot_count );
+}
+
+//Position in keys of the key with hash h: its slot, remapped below count if it lies past the end
+template <typename Type>
+bin_index_t Frozen_hash_table<Type>::position( unsigned long long h ) const {
+	bin_index_t s = slot( h, pilot[h % bucket_count] );
+
+	return (s < count) ? s : remap[s - count];
+}
+
+//Chooses a pilot for every bucket, largest buckets first, so that all keys land in distinct
+//slots, then pairs the slots taken past count with the free ones below it. On success,
+//replaces each h[i] by the position of key i and returns true.
+//Sets duplicate if two keys have the same hash, since then no pilot can separate them
+template <typename Type>
+bool Frozen_hash_table<Type>::build( unsigned long long *h, bool &duplicate ) {
+	for ( bin_index_t b = 0; b < bucket_count; ++b ) {
+		pilot[b] = 0;
+	}
+
+	if ( count == 0 ) {
+		return true;
+	}
+
+	//Group the hashes by bucket (counting sort): members[start[b]..start[b + 1]) are the hashes
+	//of the keys of bucket b, stored together so that the pilot search reads them sequentially
+	bin_index_t *start = new bin_index_t[bucket_count + 1];
+	unsigned long long *members = new unsigned long long[count];
+
+	for ( bin_index_t b = 0; b <= bucket_count; ++b ) {
+		start[b] = 0;
+	}
+
+	for ( bin_index_t i = 0; i < count; ++i ) {
+		++start[h[i] % bucket_count + 1];
+	}
+
+	bin_index_t largest = 0;
+
+	for ( bin_index_t b = 0; b < bucket_count; ++b ) {
+		if ( start[b + 1] > largest ) {
+			largest = start[b + 1];
+		}
+
+		start[b + 1] += start[b];
+	}
+
+	bin_index_t *fill = new bin_index_t[bucket_count];
+
+	for ( bin_index_t b = 0; b < bucket_count; ++b ) {
+		fill[b] = start[b];
+	}
+
+	for ( bin_index_t i = 0; i < count; ++i ) {
+		members[fill[h[i] % bucket_count]++] = h[i];
+	}
+
+	//Order the buckets by decreasing size (counting sort on the size)
+	bin_index_t *by_size = new bin_index_t[largest + 2];
+	bin_index_t *order = new bin_index_t[bucket_count];
+
+	for ( bin_index_t s = 0; s <= largest + 1; ++s ) {
+		by_size[s] = 0;
+	}
+
+	for ( bin_index_t b = 0; b < bucket_count; ++b ) {
+		++by_size[largest - (start[b + 1] - start[b]) + 1];
+	}
+
+	for ( bin_index_t s = 0; s <= largest; ++s ) {
+		by_size[s + 1] += by_size[s];
+	}
+
+	for ( bin_index_t b = 0; b < bucket_count; ++b ) {
+		order[by_size[largest - (start[b + 1] - start[b])]++] = b;
+	}
+
+	unsigned char *taken = new unsigned char[slot_count];
+	bin_index_t *slots = new bin_index_t[largest == 0 ? 1 : largest];
+	bool ok = true;
+
+	std::memset( taken, 0, slot_count );
+
+	for ( bin_index_t k = 0; k < bucket_count && ok; ++k ) {
+		bin_index_t b = order[k];
+		bin_index_t size = start[b + 1] - start[b];
+
+		if ( size == 0 ) {
+			break;
+		}
+
+		for ( bin_index_t i = start[b]; i < start[b + 1] && ok; ++i ) {
+			for ( bin_index_t j = i + 1; j < start[b + 1]; ++j ) {
+				if ( members[i] == members[j] ) {
+					duplicate = true;
+					ok = false;
+					break;
+				}
+			}
+		}
+
+		if ( !ok ) {
+			break;
+		}
+
+		unsigned int p = 0;
+
+		for ( ; p < MAX_PILOT; ++p ) {
+			bin_index_t placed = 0;
+
+			//Claim slots one key at a time; release them again on a collision
+			for ( ; placed < size; ++placed ) {
+				bin_index_t s = slot( members[start[b] + placed], p );
+
+				if ( taken[s] ) {
+					break;
+				}
+
+				taken[s] = 1;
+				slots[placed] = s;
+			}
+
+			if ( placed == size ) {
+				break;
+			}
+
+			for ( bin_index_t j = 0; j < placed; ++j ) {
+				taken[slots[j]] = 0;
+			}
+		}
+
+		if ( p == MAX_PILOT ) {
+			ok = false;
+		} else {
+			pilot[b] = p;
+		}
+	}
+
+	if ( ok ) {
+		//As many slots below count are free as there are taken slots past it. A free slot past
+		//count can still be reached by a key that is not in the table, so it maps to slot 0
+		bin_index_t free_slot = 0;
+
+		for ( bin_index_t s = count; s < slot_count; ++s ) {
+			remap[s - count] = 0;
+
+			if ( taken[s] ) {
+				while ( taken[free_slot] ) {
+					++free_slot;
+				}
+
+				remap[s - count] = free_slot++;
+			}
+		}
+
+		for ( bin_index_t i = 0; i < count; ++i ) {
+			h[i] = position( h[i] );
+		}
+	}
+
+	delete[] slots;
+	delete[] taken;
+	delete[] order;
+	delete[] by_size;
+	delete[] fill;
+	delete[] members;
+	delete[] start;
+
+	return ok;
+}
+
+//Accessors
+template <typename Type>
+bin_index_t Frozen_hash_table<Type>::size() const {
+	return count;
+}
+
+template <typename Type>
+bool Frozen_hash_table<Type>::empty() const {
+	return (count == 0);
+}
+
+template <typename Type>
+bool Frozen_hash_table<Type>::member( Type const &obj ) const {
+	if ( count == 0 ) {
+		return false;
+	}
+
+	return keys[position( hash( obj ) )] == obj;
+}
+
+//Returns the bytes used by the keys, the pilots and the remap table
+template <typename Type>
+bin_index_t Frozen_hash_table<Type>::memory_bytes() const {
+	return count*sizeof( Type ) + bucket_count*sizeof( unsigned int ) + (slot_count - count)*sizeof( bin_index_t );
+}
+
+#endif
@@ -0,0 +1,182 @@
+#ifndef FROZEN_HASH_TABLE_TESTER_H
+#define FROZEN_HASH_TABLE_TESTER_H
+
+#ifndef nullptr
+#define nullptr 0
+#endif
+
+#include "Exceptions.h"
+#include "Test.h"
+#include "Hash_Table.h"
+#include "Frozen_Hash_Table.h"
+
+#include <iostream>
+
+
+template <typename Type>
+class Frozen_hash_table_tester:public test< Frozen_hash_table<Type> > {
+	using test< Frozen_hash_table<Type> >::object;
+	using test< Frozen_hash_table<Type> >::command;
+
+	private:
+		Hash_table<Type> *source;	//The table that freeze copies
+
+	public:
+		Frozen_hash_table_tester(Frozen_hash_table<Type> *obj =
+0 ):test< Frozen_hash_table<Type> >(obj), source(nullptr ){
+			//empty
+		}
+
+		~Frozen_hash_table_tester(){
+			delete source;
+		}
+
+		void process();
+};
+
+template <typename Type>
+void Frozen_hash_table_tester<Type>::process() {
+	if(command == "source:"){
+		//Replace the source by an empty table of 2^n bins
+
+		int n;
+
+		std::cin >> n;
+
+		delete source;
+		source = new Hash_table<Type>(n );
+		std::cout << "Okay" << std::endl;
+	} else if(command == "insert"){
+		//Insert the next value read into the source
+
+		Type n;
+
+		std::cin >> n;
+
+		source->insert(n );
+		std::cout << "Okay" << std::endl;
+	} else if(command == "insert_range"){
+		//Insert a, a + 1, ..., b - 1 into the source
+
+		Type a;
+		Type b;
+
+		std::cin >> a;
+		std::cin >> b;
+
+		for(Type n = a; n < b; ++n){
+			source->insert(n );
+		}
+
+		std::cout << "Okay" << std::endl;
+	} else if(command == "erase"){
+		Type n;
+
+		std::cin >> n;
+
+		source->erase(n );
+		std::cout << "Okay" << std::endl;
+	} else if(command == "enable_ttl"){
+		unsigned int ttl;
+
+		std::cin >> ttl;
+
+		source->enable_ttl(ttl );
+		std::cout << "Okay" << std::endl;
+	} else if(command == "set_time"){
+		unsigned int t;
+
+		std::cin >> t;
+
+		source->set_time(t );
+		std::cout << "Okay" << std::endl;
+	} else if(command == "freeze"){
+		//Build the object from the source
+
+		object = new Frozen_hash_table<Type>(*source );
+		std::cout << "Okay" << std::endl;
+	} else if(command == "size"){
+		//Check if the size equals the next integer read
+
+		bin_index_t expected_size;
+
+		std::cin >> expected_size;
+
+		bin_index_t actual_size = object->size();
+
+		if(actual_size == expected_size){
+			std::cout << "Okay" << std::endl;
+		} else {
+			std::cout << ": Failed size(): expecting the value '" << expected_size << "' but got '" << actual_size << "'" << std::endl;
+		}
+	} else if(command == "empty"){
+		//Check if the empty status equals the next Boolean read
+
+		bool expected_empty;
+
+		std::cin >> expected_empty;
+
+		bool actual_empty = object->empty();
+
+		if(actual_empty == expected_empty){
+			std::cout << "Okay" << std::endl;
+		} else {
+			std::cout << ": Failed empty(): expecting the value '" << expected_empty << "' but got '" << actual_empty << "'" << std::endl;
+		}
+	} else if(command == "member"){
+		//Check if the element is in the object
+
+		Type n;
+		bool expected_member;
+
+		std::cin >> n;
+		std::cin >> expected_member;
+
+		bool actual_member = object->member(n );
+
+		if(actual_member == expected_member){
+			std::cout << "Okay" << std::endl;
+		} else {
+			std::cout << ": Failed member(" << n << "): expecting the value '" << expected_member << "' but got '" << actual_member << "'" << std::endl;
+		}
+	} else if(command == "member_range"){
+		//Check member for a, a + 1, ..., b - 1 against the Boolean read
+
+		Type a;
+		Type b;
+		bool expected_member;
+
+		std::cin >> a;
+		std::cin >> b;
+		std::cin >> expected_member;
+
+		Type n = a;
+
+		while(n < b && object->member(n ) == expected_member){
+			++n;
+		}
+
+		if(n == b){
+			std::cout << "Okay" << std::endl;
+		} else {
+			std::cout << ": Failed member(" << n << "): expecting the value '" << expected_member << "' but got '" << !expected_member << "'" << std::endl;
+		}
+	} else if(command == "memory_bytes"){
+		//Check if the memory used equals the next integer read
+
+		bin_index_t expected_bytes;
+
+		std::cin >> expected_bytes;
+
+		bin_index_t actual_bytes = object->memory_bytes();
+
+		if(actual_bytes == expected_bytes){
+			std::cout << "Okay" << std::endl;
+		} else {
+			std::cout << ": Failed memory_bytes(): expecting the value '" << expected_bytes << "' but got '" << actual_bytes << "'" << std::endl;
+		}
+	} else {
+		std::cout << command << ": Command not found." << std::endl;
+	}
+}
+#endif
@@ -0,0 +1,56 @@
+#ifndef HASH_FUNCTIONS_H
+#define HASH_FUNCTIONS_H
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+//splitmix64 finalizer: a bijection on 64-bit values that spreads every input bit over all of
+//the output bits, so keys that differ only in a few bits (or share their low bits) end up far apart
+inline unsigned long long splitmix64( unsigned long long h ) {
+	h ^= h >> 30;
+	h *= 0xBF58476D1CE4E5B9ULL;
+	h ^= h >> 27;
+	h *= 0x94D049BB133111EBULL;
+	h ^= h >> 31;
+	return h;
+}
+
+//64-bit hash of n bytes: FNV-1a, then the splitmix64 finalizer
+inline unsigned long long hash_bytes( void const *data, size_t n ) {
+	unsigned char const *bytes = static_cast<unsigned char const *>( data );
+	unsigned long long h = 0xCBF29CE484222325ULL;
+
+	for ( size_t i = 0; i < n; ++i ) {
+		h = (h ^ bytes[i])*0x100000001B3ULL;
+	}
+
+	return splitmix64( h );
+}
+
+//Integer identifying a key, for tables that must tell apart every pair of unequal keys.
+//Floating-point keys use their bits, with -0.0 taken as 0.0, so that keys differing only in
+//their fractional part differ here too; other keys use their long long value. Keys that compare
+//equal give the same integer. (Hash_table itself hashes every type by its long long value, so
+//there 2.5 and 2.7 share a home bin.)
+template <typename Type>
+inline unsigned long long key_bits( Type const &obj, std::true_type ) {
+	Type value = (obj == 0) ? 0 : obj;
+	unsigned long long bits = 0;
+
+	std::memcpy( &bits, &value, sizeof( value ) < sizeof( bits ) ? sizeof( value ) : sizeof( bits ) );
+
+	return bits;
+}
+
+template <typename Type>
+inline unsigned long long key_bits( Type const &obj, std::false_type ) {
+	return static_cast<unsigned long long>( static_cast<long long>( obj ) );
+}
+
+template <typename Type>
+inline unsigned long long key_bits( Type const &obj ) {
+	return key_bits( obj, std::is_floating_point<Type>() );
+}
+
+#endif
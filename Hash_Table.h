@@ -7,72 +7,522 @@
 
 #include "Exceptions.h"
 #include "Mem_Allocation.h"
+#include "Bloom_Filter.h"
+#include "Hash_Functions.h"
 
-enum bin_state_t { UNOCCUPIED, OCCUPIED, ERASED };
+#include <cstring>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+//Sizes, counts and bin numbers are 64-bit so that tables can grow past 2^31 bins
+typedef long long bin_index_t;
+
+enum bin_state_t : unsigned char { UNOCCUPIED, OCCUPIED, ERASED };
 
 template <typename Type>
 class Hash_table {
 	private:
-		int count;
+		static const int SWEEP_STEP = 4;	//Bins the TTL sweeper examines on each insert
+
+		mutable bin_index_t count;	//Mutable since member() reclaims expired elements
 		int power;
-		int array_size;
-		int mask;
+		bin_index_t array_size;
+		bin_index_t mask;
 		Type *array;
 		bin_state_t *occupied;
-		int empty_bin;				//Keeps count of empty bins
+		mutable bin_index_t empty_bin;		//Keeps count of empty bins
+		Bloom_filter *filter;		//Optional filter for rejecting misses, nullptr when disabled
+		mutable bin_index_t filter_erased;	//Erasures since the filter was last rebuilt
+		unsigned char *referenced;	//CLOCK reference bit per bin in cache mode, nullptr otherwise
+		bin_index_t cache_limit;	//Number of elements at which cache mode starts evicting
+		bin_index_t hand;			//Next bin the CLOCK sweep examines
+		unsigned int *expiry;		//Expiry time per bin in TTL mode, nullptr otherwise
+		unsigned int time_to_live;	//Lifetime given to inserted elements in TTL mode
+		unsigned int now;			//Current time, as last set by set_time()
+		unsigned int swept;			//Time of the last sweep of every bin in TTL mode
+		bin_index_t sweeper;		//Next bin the TTL sweeper examines
+
+		bin_index_t hash( Type const & ) const;
+		unsigned long long fingerprint( Type const & ) const;
+		bin_index_t locate( Type const & ) const;
+		bool expired( unsigned int ) const;
+		bool live( bin_index_t ) const;
+		bin_index_t live_count() const;
+		void reclaim( bin_index_t ) const;
+		template <typename Arg>
+		void insert_one( Arg && );
+		template <typename Arg>
+		bin_index_t insert_new( Arg && );
+		void erase_bin( bin_index_t );
+		void evict();
+		void scale_cache_limit( int );
+		void reset( int );
+		void rehash( int );
+		template <typename Predicate>
+		bin_index_t sweep( Predicate, bool );
+		void copy_bins( Hash_table const &, std::true_type );
+		void copy_bins( Hash_table const &, std::false_type );
+		void destroy_elements();
+		void release();
 
-		int hash( Type const & ) const;
+		static Type *allocate_bins( bin_index_t );
+		static void deallocate_bins( Type * );
+
+		static int power_for( bin_index_t );
+		static bin_index_t probe_bins( Hash_table const &, Hash_table const &, unsigned char *, bin_index_t & );
 
 	public:
 		Hash_table( int = 5 );
+		Hash_table( Hash_table const & );
+		Hash_table( Hash_table const &, bool );
+		Hash_table( Hash_table && );
 		~Hash_table();
-		int size() const;
-		int capacity() const;
+		Hash_table &operator=( Hash_table const & );
+		Hash_table &operator=( Hash_table && );
+		bin_index_t size() const;
+		bin_index_t capacity() const;
 		double load_factor() const;
 		bool empty() const;
 		bool member( Type const & ) const;
-		Type bin( int ) const;
+		Type bin( bin_index_t ) const;
+		void prefetch( Type const & ) const;
 
 		void print() const;
 
 		void insert( Type const & );
+		void insert( Type && );
+		template <typename... Args>
+		void emplace( Args &&... );
 		bool erase( Type const & );
 		void clear();
+		void reserve( bin_index_t );
+		void shrink_to_fit();
+
+		template <typename Predicate>
+		bin_index_t erase_if( Predicate );
+		template <typename Predicate>
+		bin_index_t retain_if( Predicate );
+
+		void enable_filter();
+		void disable_filter();
+		void rebuild_filter();
+
+		void enable_cache( double );
+		void disable_cache();
+
+		void enable_ttl( unsigned int );
+		void disable_ttl();
+		void set_time( unsigned int );
+		bin_index_t expire( bin_index_t );
+
+		void intersect( Hash_table const &, Hash_table & ) const;
+		void unite( Hash_table const &, Hash_table & ) const;
+		void subtract( Hash_table const &, Hash_table & ) const;
+		bool is_subset( Hash_table const & ) const;
 
 	// Friends
 
 	template <typename T>
 	friend std::ostream &operator<<( std::ostream &, Hash_table<T> const & );
+
+	template <typename T>
+	friend class Frozen_hash_table;
+
+	template <typename T>
+	friend class Logged_hash_table;
+
+	template <typename T>
+	friend class Spilling_hash_table;
+
+	template <typename T>
+	friend class Counting_hash_table;
+
+	template <typename T>
+	friend class Hash_table_tester;
 };
 
 //Constructor
 template <typename Type>
 Hash_table<Type>::Hash_table( int m ):
 count( 0 ), power( m ),
-array_size( 1 << power ),
+array_size( static_cast<bin_index_t>( 1 ) << power ),
 mask( array_size - 1 ),
-array( new Type[array_size] ),
-occupied( new bin_state_t[array_size] ) {
+array( allocate_bins( array_size ) ),
+occupied( new bin_state_t[array_size] ),
+filter( nullptr ),
+filter_erased( 0 ),
+referenced( nullptr ),
+cache_limit( 0 ),
+hand( 0 ),
+expiry( nullptr ),
+time_to_live( 0 ),
+now( 0 ),
+swept( 0 ),
+sweeper( 0 ) {
 	this->empty_bin = 0;
-	for ( int i = 0; i < array_size; i++ ) {
+	for ( bin_index_t i = 0; i < array_size; i++ ) {
 		occupied[i] = UNOCCUPIED;
 	}
 }
 
-// Your implementation here
+//Copy constructor
+//Trivially copyable keys are copied with one memcpy per array
+template <typename Type>
+Hash_table<Type>::Hash_table( Hash_table const &other ):
+count( other.count ), power( other.power ),
+array_size( other.array_size ),
+mask( other.mask ),
+array( allocate_bins( array_size ) ),
+occupied( new bin_state_t[array_size] ),
+empty_bin( other.empty_bin ),
+filter( other.filter == nullptr ? nullptr : new Bloom_filter( *other.filter ) ),
+filter_erased( other.filter_erased ),
+referenced( other.referenced == nullptr ? nullptr : new unsigned char[array_size] ),
+cache_limit( other.cache_limit ),
+hand( other.hand ),
+expiry( other.expiry == nullptr ? nullptr : new unsigned int[array_size] ),
+time_to_live( other.time_to_live ),
+now( other.now ),
+swept( other.swept ),
+sweeper( other.sweeper ) {
+	try {
+		copy_bins( other, std::integral_constant<bool, std::is_trivially_copyable<Type>::value>() );
+	} catch ( ... ) {
+		release();
+		throw;
+	}
+
+	if ( referenced != nullptr ) {
+		std::memcpy( referenced, other.referenced, array_size );
+	}
+
+	if ( expiry != nullptr ) {
+		std::memcpy( expiry, other.expiry, array_size*sizeof( unsigned int ) );
+	}
+}
+
+//Copy constructor that, if compact is true, rehashes the elements into the new bins
+//instead of copying them, so the copy has the same capacity but no erased bins
+template <typename Type>
+Hash_table<Type>::Hash_table( Hash_table const &other, bool compact ):
+count( 0 ), power( other.power ),
+array_size( other.array_size ),
+mask( other.mask ),
+array( allocate_bins( array_size ) ),
+occupied( new bin_state_t[array_size] ),
+empty_bin( 0 ),
+filter( other.filter == nullptr ? nullptr : new Bloom_filter( array_size ) ),
+filter_erased( 0 ),
+referenced( other.referenced == nullptr ? nullptr : new unsigned char[array_size] ),
+cache_limit( other.cache_limit ),
+hand( 0 ),
+expiry( other.expiry == nullptr ? nullptr : new unsigned int[array_size] ),
+time_to_live( other.time_to_live ),
+now( other.now ),
+swept( other.swept ),
+sweeper( 0 ) {
+	//A key whose copy throws leaves the bins copied so far consistent, so release() can undo them
+	try {
+		if ( !compact || other.empty_bin == 0 ) {
+			count = other.count;
+			empty_bin = other.empty_bin;
+			copy_bins( other, std::integral_constant<bool, std::is_trivially_copyable<Type>::value>() );
+
+			if ( filter != nullptr ) {
+				*filter = *other.filter;
+				filter_erased = other.filter_erased;
+			}
+
+			if ( referenced != nullptr ) {
+				std::memcpy( referenced, other.referenced, array_size );
+				hand = other.hand;
+			}
+
+			if ( expiry != nullptr ) {
+				std::memcpy( expiry, other.expiry, array_size*sizeof( unsigned int ) );
+				sweeper = other.sweeper;
+			}
+		} else {
+			for ( bin_index_t i = 0; i < array_size; i++ ) {
+				occupied[i] = UNOCCUPIED;
+			}
+
+			//Expired elements are dropped along with the erased bins
+			for ( bin_index_t i = 0; i < array_size; i++ ) {
+				if ( other.live( i ) ) {
+					bin_index_t b = insert_new( other.array[i] );
+
+					if ( referenced != nullptr ) {
+						referenced[b] = other.referenced[i];
+					}
+
+					if ( expiry != nullptr ) {
+						expiry[b] = other.expiry[i];
+					}
+				}
+			}
+		}
+	} catch ( ... ) {
+		release();
+		throw;
+	}
+}
+
+//Move constructor
+//Takes the bins of other and leaves it an empty table of two bins, which are allocated
+//first so that other keeps its bins if that throws
+template <typename Type>
+Hash_table<Type>::Hash_table( Hash_table &&other ):
+count( other.count ), power( other.power ),
+array_size( other.array_size ),
+mask( other.mask ),
+array( other.array ),
+occupied( other.occupied ),
+empty_bin( other.empty_bin ),
+filter( other.filter ),
+filter_erased( other.filter_erased ),
+referenced( other.referenced ),
+cache_limit( other.cache_limit ),
+hand( other.hand ),
+expiry( other.expiry ),
+time_to_live( other.time_to_live ),
+now( other.now ),
+swept( other.swept ),
+sweeper( other.sweeper ) {
+	Type *empty_array = allocate_bins( 2 );
+	bin_state_t *empty_occupied;
+
+	try {
+		empty_occupied = new bin_state_t[2];
+	} catch ( ... ) {
+		deallocate_bins( empty_array );
+		throw;
+	}
+
+	empty_occupied[0] = UNOCCUPIED;
+	empty_occupied[1] = UNOCCUPIED;
+
+	other.count = 0;
+	other.power = 1;
+	other.array_size = 2;
+	other.mask = 1;
+	other.array = empty_array;
+	other.occupied = empty_occupied;
+	other.empty_bin = 0;
+	other.filter = nullptr;
+	other.filter_erased = 0;
+	other.referenced = nullptr;
+	other.cache_limit = 0;
+	other.hand = 0;
+	other.expiry = nullptr;
+	other.time_to_live = 0;
+	other.sweeper = 0;
+}
 
 //Desctructor
 //Free up mem allocated by constructor
 template<typename Type>
 Hash_table<Type>::~Hash_table() {
+	release();
+}
+
+//Destroys the elements and frees every array; used by the destructor and by a copy that throws
+template<typename Type>
+void Hash_table<Type>::release() {
+	delete filter;						//Deallocates the Bloom filter, if one was enabled
+	delete[] referenced;				//Deallocates the reference bits, if cache mode was enabled
+	delete[] expiry;					//Deallocates the expiry times, if TTL mode was enabled
+	destroy_elements();					//Destroys the elements still in the table
 	delete[] occupied;					//Deallocates mem for state array of hash table
-	delete[] array;						//Deallocates mem for key array of hash table
+	deallocate_bins( array );			//Deallocates mem for key array of hash table
+}
+
+//Copy assignment
+//The existing bins are reused when the capacities match and the keys are trivially copyable;
+//otherwise a copy is built and swapped in. Either way everything that may throw is allocated
+//before this table is changed, so an exception leaves it as it was
+template<typename Type>
+Hash_table<Type> &Hash_table<Type>::operator=(Hash_table const &rhs) {
+	if(this == &rhs)
+	{
+		return *this;
+	}
+	if(this->array_size != rhs.array_size || !std::is_trivially_copyable<Type>::value)
+	{
+		Hash_table copy(rhs);
+		return *this = std::move(copy);
+	}
+
+	Bloom_filter *new_filter = nullptr;
+	unsigned char *new_referenced = nullptr;
+	unsigned int *new_expiry = nullptr;
+	try
+	{
+		if(rhs.filter != nullptr)
+		{
+			new_filter = new Bloom_filter(*rhs.filter);
+		}
+		if(rhs.referenced != nullptr && this->referenced == nullptr)
+		{
+			new_referenced = new unsigned char[this->array_size];
+		}
+		if(rhs.expiry != nullptr && this->expiry == nullptr)
+		{
+			new_expiry = new unsigned int[this->array_size];
+		}
+	}
+	catch(...)
+	{
+		delete new_filter;
+		delete[] new_referenced;
+		throw;
+	}
+
+	this->copy_bins(rhs, std::integral_constant<bool, std::is_trivially_copyable<Type>::value>());
+	this->count = rhs.count;
+	this->empty_bin = rhs.empty_bin;
+
+	delete this->filter;
+	this->filter = new_filter;
+	this->filter_erased = rhs.filter_erased;
+
+	if(rhs.referenced == nullptr)
+	{
+		delete[] this->referenced;
+		this->referenced = nullptr;
+	}
+	else
+	{
+		if(this->referenced == nullptr)
+		{
+			this->referenced = new_referenced;
+		}
+		std::memcpy(this->referenced, rhs.referenced, this->array_size);
+	}
+	this->cache_limit = rhs.cache_limit;
+	this->hand = rhs.hand;
+
+	if(rhs.expiry == nullptr)
+	{
+		delete[] this->expiry;
+		this->expiry = nullptr;
+	}
+	else
+	{
+		if(this->expiry == nullptr)
+		{
+			this->expiry = new_expiry;
+		}
+		std::memcpy(this->expiry, rhs.expiry, this->array_size*sizeof(unsigned int));
+	}
+	this->time_to_live = rhs.time_to_live;
+	this->now = rhs.now;
+	this->swept = rhs.swept;
+	this->sweeper = rhs.sweeper;
+	return *this;
+}
+
+//Move assignment: swaps the bins, so the old bins of this table are freed with rhs
+template<typename Type>
+Hash_table<Type> &Hash_table<Type>::operator=(Hash_table &&rhs) {
+	std::swap(this->count, rhs.count);
+	std::swap(this->power, rhs.power);
+	std::swap(this->array_size, rhs.array_size);
+	std::swap(this->mask, rhs.mask);
+	std::swap(this->array, rhs.array);
+	std::swap(this->occupied, rhs.occupied);
+	std::swap(this->empty_bin, rhs.empty_bin);
+	std::swap(this->filter, rhs.filter);
+	std::swap(this->filter_erased, rhs.filter_erased);
+	std::swap(this->referenced, rhs.referenced);
+	std::swap(this->cache_limit, rhs.cache_limit);
+	std::swap(this->hand, rhs.hand);
+	std::swap(this->expiry, rhs.expiry);
+	std::swap(this->time_to_live, rhs.time_to_live);
+	std::swap(this->now, rhs.now);
+	std::swap(this->swept, rhs.swept);
+	std::swap(this->sweeper, rhs.sweeper);
+	return *this;
+}
+
+//Copies the bins of other, which has the same capacity, into bins holding no elements
+template<typename Type>
+void Hash_table<Type>::copy_bins(Hash_table const &other, std::true_type) {
+	std::memcpy(this->array, other.array, this->array_size*sizeof(Type));
+	std::memcpy(this->occupied, other.occupied, this->array_size*sizeof(bin_state_t));
+}
+
+//A bin is marked occupied only once its element is constructed. If a copy throws, the elements
+//copied so far are destroyed and every bin is left unoccupied
+template<typename Type>
+void Hash_table<Type>::copy_bins(Hash_table const &other, std::false_type) {
+	bin_index_t i = 0;
+	try
+	{
+		for(; i < this->array_size; i++)
+		{
+			if(other.occupied[i] == OCCUPIED)
+			{
+				new (this->array + i) Type(other.array[i]);
+			}
+			this->occupied[i] = other.occupied[i];
+		}
+	}
+	catch(...)
+	{
+		for(bin_index_t j = 0; j < i; j++)
+		{
+			if(this->occupied[j] == OCCUPIED)
+			{
+				this->array[j].~Type();
+			}
+		}
+		for(bin_index_t j = 0; j < this->array_size; j++)
+		{
+			this->occupied[j] = UNOCCUPIED;
+		}
+		throw;
+	}
+}
+
+//Destroys every element in the table, leaving the bin states unchanged
+template<typename Type>
+void Hash_table<Type>::destroy_elements() {
+	if(!std::is_trivially_destructible<Type>::value && this->array != nullptr)
+	{
+		for(bin_index_t i = 0; i < this->array_size; i++)
+		{
+			if(this->occupied[i] == OCCUPIED)
+			{
+				this->array[i].~Type();
+			}
+		}
+	}
+}
+
+//Bins are raw storage: an element is constructed in its bin when inserted and destroyed
+//when erased, so empty bins never construct or destroy a Type.
+//Throws overflow if n bins do not fit in the address space
+template<typename Type>
+Type *Hash_table<Type>::allocate_bins(bin_index_t n) {
+	if(static_cast<unsigned long long>(n) > std::numeric_limits<std::size_t>::max() / sizeof(Type))
+	{
+		throw overflow();
+	}
+	return static_cast<Type *>(::operator new(static_cast<std::size_t>(n)*sizeof(Type)));
+}
+
+template<typename Type>
+void Hash_table<Type>::deallocate_bins(Type *bins) {
+	::operator delete(static_cast<void *>(bins));
 }
 
 //Hash frunction: modified quadratic probing
 template<typename Type>
-int Hash_table<Type>::hash(Type const &obj) const {
-	int i = static_cast<int>(obj) % this->array_size;
+bin_index_t Hash_table<Type>::hash(Type const &obj) const {
+	bin_index_t i = static_cast<long long>(obj) % this->array_size;
 	if(i < 0)
 	{
 		i += this->array_size;
@@ -80,14 +530,21 @@ int Hash_table<Type>::hash(Type const &obj) const {
 	return i;
 }
 
+//Fingerprint for the Bloom filter: the same integer the hash function starts from,
+//scrambled (splitmix64 finalizer) so that nearby keys land in unrelated blocks
+template<typename Type>
+unsigned long long Hash_table<Type>::fingerprint(Type const &obj) const {
+	return splitmix64(static_cast<unsigned long long>(static_cast<long long>(obj)));
+}
+
 //Accessors
 template<typename Type>
-int Hash_table<Type>::size() const {
+bin_index_t Hash_table<Type>::size() const {
 	return this->count;					//Returns the number of elements in the hash table
 }
 
 template<typename Type>
-int Hash_table<Type>::capacity() const {
+bin_index_t Hash_table<Type>::capacity() const {
 	return this->array_size;			//Returns the total size of the hash table
 }
 
@@ -103,18 +560,25 @@ bool Hash_table<Type>::empty() const {
 	return(this->count == 0);			//Returns true if hash table has no elements and returns false if it has
 }
 
+//Returns the bin holding obj, or -1 if obj is not in the table. In TTL mode the element in
+//that bin may have expired
 template<typename Type>
-bool Hash_table<Type>::member(Type const &obj) const {
+bin_index_t Hash_table<Type>::locate(Type const &obj) const {
+	//A negative answer from the filter is definite, so skip the probe sequence
+	if(this->filter != nullptr && !this->filter->may_contain(this->fingerprint(obj)))
+	{
+		return -1;
+	}
 	//Hash obj to find initial bin
-	int probe = this->hash(obj);
-	int offset = 1;
-	int counter = this->array_size;
+	bin_index_t probe = this->hash(obj);
+	bin_index_t offset = 1;
+	bin_index_t counter = this->array_size;
 	//Loop through array to find whether or not obj is an element
 	while(this->occupied[probe] != UNOCCUPIED)
 	{
 		if(this->occupied[probe] == ERASED)
 		{
-			probe = (probe + offset) % this->array_size;
+			probe = (probe + offset) & this->mask;
 			counter -= 1;
 			offset +=1;
 			if(counter == 0)
@@ -124,118 +588,233 @@ bool Hash_table<Type>::member(Type const &obj) const {
 		}
 		else
 		{
-			//If obj is found, return true
+			//If obj is found, return its bin
 			if(this->array[probe] == obj)
 			{
-				return true;
+				return probe;
 			}
 			//Else, go to next offset and check again
 			else
 			{
-				probe = (probe + offset) % this->array_size;
+				probe = (probe + offset) & this->mask;
 				counter -= 1;;
 				offset += 1;
 				//If counter goes down to 0, entire array has been searched
 				if(counter == 0)
 				{
-					//Return false since element is not part of array
+					//Return -1 since element is not part of array
 					break;
 				}
 			}
 		}
 	}
-	return false;
+	return -1;
+}
+
+template<typename Type>
+bool Hash_table<Type>::member(Type const &obj) const {
+	bin_index_t n = this->locate(obj);
+	if(n < 0)
+	{
+		return false;
+	}
+	//In TTL mode an expired element is absent; its bin is reclaimed on the spot
+	if(this->expiry != nullptr && this->expired(this->expiry[n]))
+	{
+		this->reclaim(n);
+		return false;
+	}
+	//In cache mode a hit marks the bin as recently used
+	if(this->referenced != nullptr)
+	{
+		this->referenced[n] = 1;
+	}
+	return true;
 }
 
 template<typename Type>
-Type Hash_table<Type>::bin(int n) const {
+Type Hash_table<Type>::bin(bin_index_t n) const {
 	return this->array[n];				//Returns element stored in location n
 }
 
+//Hints the cache to fetch the home bin of obj, so a later member() call on it does not stall.
+//Issue it for a batch of keys before probing any of them
+template<typename Type>
+void Hash_table<Type>::prefetch(Type const &obj) const {
+#if defined(__GNUC__)
+	bin_index_t probe = this->hash(obj);
+	__builtin_prefetch(this->occupied + probe);
+	__builtin_prefetch(this->array + probe);
+#endif
+	(void)obj;
+}
+
 //Mutators
 template<typename Type>
 void Hash_table<Type>::insert(Type const &obj) {
-	//Check if table is full, throw overflow if it is
-	if(this->count >= this->array_size)
+	this->insert_one(obj);
+}
+
+//Moves obj into its bin instead of copying it
+template<typename Type>
+void Hash_table<Type>::insert(Type &&obj) {
+	this->insert_one(std::move(obj));
+}
+
+//Constructs the element from args and moves it into its bin. The element has to exist
+//before its bin is known, so this is one construction and one move, with no copies
+template<typename Type>
+template<typename... Args>
+void Hash_table<Type>::emplace(Args &&... args) {
+	Type obj(std::forward<Args>(args)...);
+	this->insert_one(std::move(obj));
+}
+
+template<typename Type>
+template<typename Arg>
+void Hash_table<Type>::insert_one(Arg &&obj) {
+	//In TTL mode, advance the sweeper; a full table is swept whole before it overflows
+	if(this->expiry != nullptr)
+	{
+		this->expire(this->count >= this->array_size ? this->array_size : SWEEP_STEP);
+	}
+	//Outside cache mode, check if table is full, throw overflow if it is, even if obj is a member
+	if(this->referenced == nullptr && this->count >= this->array_size)
 	{
 		throw overflow();
 	}
-	//If obj is a member, don't do anything
-	else if(this->member(obj))
+	bin_index_t n = this->locate(obj);
+	//If obj is a member, don't do anything beyond marking it used and restarting its lifetime
+	if(n >= 0 && this->live(n))
 	{
+		if(this->referenced != nullptr)
+		{
+			this->referenced[n] = 1;
+		}
+		if(this->expiry != nullptr)
+		{
+			this->expiry[n] = this->now + this->time_to_live;
+		}
 		return;
 	}
 	//If not, hash obj and go from there
 	else
 	{
-		int probe = this->hash(obj);
-		int offset = 1;
-		//Loop through to find the next empty or unoccupied location
-		while(this->occupied[probe] == OCCUPIED)
+		//An expired copy of obj gives up its bin first
+		if(n >= 0)
 		{
-			probe = (probe + offset) % this->array_size;
-			offset += 1;
+			this->reclaim(n);
 		}
-		if(this->occupied[probe] == ERASED)
+		//In cache mode, make room by evicting a cold element instead of filling up;
+		//this comes before the overflow check so that a cache limit of every bin still works
+		if(this->referenced != nullptr && this->count >= this->cache_limit)
 		{
-			if(this->empty_bin == 0)
-			{
-				this->empty_bin = 0;
-			}
-			else
-			{
-				this->empty_bin--;
-			}
+			this->evict();
+		}
+		//Check if table is still full after that, throw overflow if it is
+		if(this->count >= this->array_size)
+		{
+			throw overflow();
 		}
-		//Insert new element at empty location, change state at location and increment count
-		this->array[probe] = obj;
-		this->occupied[probe] = OCCUPIED;
-		this->count++;
+		this->insert_new(std::forward<Arg>(obj));
 		return;
 	}
 }
 
+//Places obj in the first erased, expired or unoccupied bin of its probe sequence and returns that bin.
+//The caller guarantees that obj is not already a member and that a free bin exists
 template<typename Type>
-bool Hash_table<Type>::erase(Type const &obj) {
-	//Check if obj is a member of the hash table
-	if(this->member(obj))
+template<typename Arg>
+bin_index_t Hash_table<Type>::insert_new(Arg &&obj) {
+	bin_index_t probe = this->hash(obj);
+	bin_index_t offset = 1;
+	//Loop through to find the next empty or unoccupied location; expired bins count as erased
+	while(this->occupied[probe] == OCCUPIED && (this->expiry == nullptr || !this->expired(this->expiry[probe])))
+	{
+		probe = (probe + offset) & this->mask;
+		offset += 1;
+	}
+	if(this->occupied[probe] == OCCUPIED)
+	{
+		this->reclaim(probe);
+	}
+	if(this->occupied[probe] == ERASED)
 	{
-		int probe = this->hash(obj);
-		int offset = 1;
-		//If location is not unoccupied
-		while(this->occupied[probe] != UNOCCUPIED)
+		if(this->empty_bin == 0)
 		{
-			if(this->occupied[probe] == ERASED)
-			{
-				probe = (probe + offset) % this->array_size;
-				offset += 1;
-			}
-			else
-			{
-				//If obj is in location, break out of loop
-				if(this->array[probe] == obj)
-				{
-					break;
-				}
-				//If obj is not in location, apply offset and check again
-				else
-				{
-					probe = (probe + offset) % this->array_size;
-					offset += 1;
-				}
-			}
+			this->empty_bin = 0;
+		}
+		else
+		{
+			this->empty_bin--;
 		}
-		//After obj is found, change state in state array, delete element at that location and decrement number of elements in hash table
-		this->occupied[probe] = ERASED;
-		//this->array[probe] = 0;
-		this->count--;
-		this->empty_bin++;
-		return true;
 	}
-	else
+	//Construct new element at empty location, change state at location and increment count
+	new (this->array + probe) Type(std::forward<Arg>(obj));
+	this->occupied[probe] = OCCUPIED;
+	this->count++;
+	if(this->filter != nullptr)
+	{
+		this->filter->add(this->fingerprint(this->array[probe]));
+	}
+	if(this->referenced != nullptr)
+	{
+		this->referenced[probe] = 1;
+	}
+	if(this->expiry != nullptr)
+	{
+		this->expiry[probe] = this->now + this->time_to_live;
+	}
+	return probe;
+}
+
+template<typename Type>
+bool Hash_table<Type>::erase(Type const &obj) {
+	//Find the bin of obj, if obj is a member of the hash table
+	bin_index_t n = this->locate(obj);
+	if(n < 0)
+	{
+		return false;
+	}
+	//An expired element is already absent; just reclaim its bin
+	else if(this->expiry != nullptr && this->expired(this->expiry[n]))
 	{
+		this->reclaim(n);
 		return false;
 	}
+	//Change state in state array, delete element at that location and decrement number of elements in hash table
+	else
+	{
+		this->erase_bin(n);
+		return true;
+	}
+}
+
+//Marks the occupied bin n as erased
+template<typename Type>
+void Hash_table<Type>::erase_bin(bin_index_t n) {
+	this->reclaim(n);
+	//Bits of erased keys stay set in the filter; rebuild once enough of them have gone stale
+	if(this->filter != nullptr && this->filter_erased >= this->array_size / 4)
+	{
+		this->rebuild_filter();
+	}
+	return;
+}
+
+//Marks the occupied bin n as erased without rebuilding the filter, which leaves the table
+//unchanged as far as member() can tell; so member() may call it on expired elements
+template<typename Type>
+void Hash_table<Type>::reclaim(bin_index_t n) const {
+	this->occupied[n] = ERASED;
+	this->array[n].~Type();
+	this->count--;
+	this->empty_bin++;
+	if(this->filter != nullptr)
+	{
+		this->filter_erased++;
+	}
+	return;
 }
 
 template<typename Type>
@@ -244,19 +823,656 @@ void Hash_table<Type>::clear() {
 	//Reset all states
 	//Delete all elements
 	//Set count to 0
-	for(int i = 0; i < this->array_size; i++)
+	for(bin_index_t i = 0; i < this->array_size; i++)
 	{
+		if(this->occupied[i] == OCCUPIED)
+		{
+			this->array[i].~Type();
+		}
 		this->occupied[i] = UNOCCUPIED;
-		//this->array[i] = 0;
 	}
 	this->count = 0;
 	this->empty_bin = 0;
+	if(this->filter != nullptr)
+	{
+		this->filter->clear();
+		this->filter_erased = 0;
+	}
+	if(this->referenced != nullptr)
+	{
+		std::memset(this->referenced, 0, this->array_size);
+		this->hand = 0;
+	}
+	this->sweeper = 0;
 	return;
 }
 
+//Capacity planning
+//Smallest power such that n elements keep the load factor at or below 3/4.
+//Throws overflow if n does not fit in the largest table (2^61 bins)
+template<typename Type>
+int Hash_table<Type>::power_for(bin_index_t n) {
+	int p = 1;
+	while((static_cast<bin_index_t>(3) << p) / 4 < n)
+	{
+		if(p == 61)
+		{
+			throw overflow();
+		}
+		p++;
+	}
+	return p;
+}
+
+//Grows the table, if needed, so that n elements fit with a load factor of at most 3/4.
+//Existing bins are kept when they are already large enough
+template<typename Type>
+void Hash_table<Type>::reserve(bin_index_t n) {
+	if(n < 0)
+	{
+		throw illegal_argument();
+	}
+	int m = power_for(n);
+	if(m > this->power)
+	{
+		this->rehash(m);
+	}
+	return;
+}
+
+//Shrinks the table to the smallest capacity that holds the current elements at a load factor
+//of at most 3/4, dropping erased bins. Nothing is reallocated if the table is already that size
+//and has no erased bins
+template<typename Type>
+void Hash_table<Type>::shrink_to_fit() {
+	int m = power_for(this->count);
+	if(m < this->power || (m == this->power && this->empty_bin > 0))
+	{
+		this->rehash(m);
+	}
+	return;
+}
+
+//Removes every element for which pred returns true and returns the number removed
+template<typename Type>
+template<typename Predicate>
+bin_index_t Hash_table<Type>::erase_if(Predicate pred) {
+	return this->sweep(pred, true);
+}
+
+//Removes every element for which pred returns false and returns the number removed
+template<typename Type>
+template<typename Predicate>
+bin_index_t Hash_table<Type>::retain_if(Predicate pred) {
+	return this->sweep(pred, false);
+}
+
+//Erases every element whose pred result equals match, sweeping the bins once in order.
+//If the sweep leaves a quarter or more of the bins erased, the survivors are rehashed
+//into fresh bins so that no erased bins are left behind
+template<typename Type>
+template<typename Predicate>
+bin_index_t Hash_table<Type>::sweep(Predicate pred, bool match) {
+	bin_index_t removed = 0;
+	for(bin_index_t i = 0; i < this->array_size; i++)
+	{
+		if(this->occupied[i] == OCCUPIED)
+		{
+			//Expired elements are reclaimed on the way without being passed to pred.
+			//The counts are updated bin by bin, so they stay right if pred throws
+			bool alive = this->live(i);
+			if(!alive || static_cast<bool>(pred(this->array[i])) == match)
+			{
+				this->reclaim(i);
+				if(alive)
+				{
+					removed++;
+				}
+			}
+		}
+	}
+
+	if(this->empty_bin >= this->array_size / 4)
+	{
+		this->rehash(this->power);
+	}
+	else if(this->filter != nullptr && this->filter_erased >= this->array_size / 4)
+	{
+		this->rebuild_filter();
+	}
+	return removed;
+}
+
+//Moves every element into a fresh set of 2^m bins, leaving no erased bins.
+//Everything is allocated before the table is changed, so if an allocation throws the
+//table is left as it was. The old bins are read in one linear pass
+template<typename Type>
+void Hash_table<Type>::rehash(int m) {
+	bin_index_t new_size = static_cast<bin_index_t>(1) << m;
+	Type *new_array = allocate_bins(new_size);
+	bin_state_t *new_occupied = nullptr;
+	unsigned char *new_referenced = nullptr;
+	unsigned int *new_expiry = nullptr;
+	Bloom_filter *new_filter = nullptr;
+	try
+	{
+		new_occupied = new bin_state_t[new_size];
+		if(this->referenced != nullptr)
+		{
+			new_referenced = new unsigned char[new_size];
+		}
+		if(this->expiry != nullptr)
+		{
+			new_expiry = new unsigned int[new_size];
+		}
+		if(this->filter != nullptr)
+		{
+			new_filter = new Bloom_filter(new_size);
+		}
+	}
+	catch(...)
+	{
+		delete[] new_expiry;
+		delete[] new_referenced;
+		delete[] new_occupied;
+		deallocate_bins(new_array);
+		throw;
+	}
+
+	Type *old_array = this->array;
+	bin_state_t *old_occupied = this->occupied;
+	unsigned char *old_referenced = this->referenced;
+	unsigned int *old_expiry = this->expiry;
+	bin_index_t old_size = this->array_size;
+
+	this->array = new_array;
+	this->occupied = new_occupied;
+	if(old_referenced != nullptr)
+	{
+		this->referenced = new_referenced;
+		this->scale_cache_limit(m);
+		this->hand = 0;
+	}
+	if(old_expiry != nullptr)
+	{
+		this->expiry = new_expiry;
+		this->sweeper = 0;
+	}
+	this->power = m;
+	this->array_size = new_size;
+	this->mask = this->array_size - 1;
+	for(bin_index_t i = 0; i < this->array_size; i++)
+	{
+		this->occupied[i] = UNOCCUPIED;
+	}
+	this->count = 0;
+	this->empty_bin = 0;
+	if(this->filter != nullptr)
+	{
+		delete this->filter;
+		this->filter = new_filter;
+		this->filter_erased = 0;
+	}
+
+	for(bin_index_t i = 0; i < old_size; i++)
+	{
+		//Expired elements are dropped instead of moved
+		if(old_occupied[i] == OCCUPIED && (old_expiry == nullptr || !this->expired(old_expiry[i])))
+		{
+			bin_index_t b = this->insert_new(std::move(old_array[i]));
+			if(old_referenced != nullptr)
+			{
+				this->referenced[b] = old_referenced[i];
+			}
+			if(old_expiry != nullptr)
+			{
+				this->expiry[b] = old_expiry[i];
+			}
+		}
+		if(old_occupied[i] == OCCUPIED)
+		{
+			old_array[i].~Type();
+		}
+	}
+	delete[] old_referenced;
+	delete[] old_expiry;
+	delete[] old_occupied;
+	deallocate_bins(old_array);
+	return;
+}
+
+//Cache mode
+//Once the table holds target_load*capacity() elements, each insert of a new element first
+//evicts one element chosen by the CLOCK algorithm instead of filling up and throwing overflow.
+//member() hits set the reference bit of their bin, so recently used elements survive a sweep
+template<typename Type>
+void Hash_table<Type>::enable_cache(double target_load) {
+	if(!(target_load > 0.0 && target_load <= 1.0))
+	{
+		throw illegal_argument();
+	}
+	this->cache_limit = static_cast<bin_index_t>(target_load * this->array_size);
+	if(this->cache_limit < 1)
+	{
+		this->cache_limit = 1;
+	}
+	if(this->referenced == nullptr)
+	{
+		this->referenced = new unsigned char[this->array_size];
+		std::memset(this->referenced, 0, this->array_size);
+		this->hand = 0;
+	}
+	//Bring an already fuller table down to the target
+	while(this->count > this->cache_limit)
+	{
+		this->evict();
+	}
+	return;
+}
+
+template<typename Type>
+void Hash_table<Type>::disable_cache() {
+	delete[] this->referenced;
+	this->referenced = nullptr;
+	this->cache_limit = 0;
+	this->hand = 0;
+	return;
+}
+
+//CLOCK sweep: the hand passes over the bins, clearing the reference bit of each element
+//that has one and erasing the first element that does not
+template<typename Type>
+void Hash_table<Type>::evict() {
+	while(true)
+	{
+		bin_index_t n = this->hand;
+		this->hand = (this->hand + 1) & this->mask;
+		if(this->occupied[n] == OCCUPIED)
+		{
+			//Expired elements go first, whatever their reference bit
+			if(this->referenced[n] && this->live(n))
+			{
+				this->referenced[n] = 0;
+			}
+			else
+			{
+				this->erase_bin(n);
+				break;
+			}
+		}
+	}
+	//Evictions leave erased bins; rehash once they would make probe sequences long
+	if(this->empty_bin >= this->array_size / 4)
+	{
+		this->rehash(this->power);
+	}
+	return;
+}
+
+//Keeps the cache limit at the same fraction of the capacity when it changes to 2^m bins
+template<typename Type>
+void Hash_table<Type>::scale_cache_limit(int m) {
+	if(m > this->power)
+	{
+		this->cache_limit <<= (m - this->power);
+	}
+	else
+	{
+		this->cache_limit >>= (this->power - m);
+	}
+	if(this->cache_limit < 1)
+	{
+		this->cache_limit = 1;
+	}
+	return;
+}
+
+//TTL mode
+//Every element expires time_to_live time units after it was inserted or last reinserted,
+//measured by the clock the caller advances with set_time(). An expiry time is 32 bits per bin
+//and compared with wraparound, which is right for times less than 2^31 units from now; set_time()
+//sweeps every bin before the clock gets that far from the last such sweep, so lifetimes up to
+//2^31 - 1 units work with any clock value.
+//Expired elements are absent to member(), insert() and erase(), which reclaim their bins on the
+//spot, and insert() reuses them like erased bins
+template<typename Type>
+void Hash_table<Type>::enable_ttl(unsigned int ttl) {
+	if(ttl == 0 || ttl > 0x7FFFFFFFu)
+	{
+		throw illegal_argument();
+	}
+	this->time_to_live = ttl;
+	if(this->expiry == nullptr)
+	{
+		//Elements already in the table start their lifetime now
+		this->expiry = new unsigned int[this->array_size];
+		for(bin_index_t i = 0; i < this->array_size; i++)
+		{
+			this->expiry[i] = this->now + ttl;
+		}
+		this->swept = this->now;
+		this->sweeper = 0;
+	}
+	return;
+}
+
+template<typename Type>
+void Hash_table<Type>::disable_ttl() {
+	delete[] this->expiry;
+	this->expiry = nullptr;
+	this->time_to_live = 0;
+	this->sweeper = 0;
+	return;
+}
+
+//Sets the current time. Throws illegal_argument if t is before the current time.
+//If t is 2^31 or more units after the last sweep of every bin, the elements that expired by
+//the current time are reclaimed first; an element expired longer ago than that would compare
+//as live again. As t is less than 2^31 units ahead, every element left compares right at t
+template<typename Type>
+void Hash_table<Type>::set_time(unsigned int t) {
+	if(static_cast<int>(t - this->now) < 0)
+	{
+		throw illegal_argument();
+	}
+	if(this->expiry != nullptr && t - this->swept >= 0x80000000u)
+	{
+		this->expire(this->array_size);
+		this->swept = this->now;
+	}
+	this->now = t;
+	return;
+}
+
+//Incremental sweeper: examines the next budget bins after where the last call stopped and
+//reclaims the expired elements among them, so bins that member() never reaches are freed too.
+//insert() runs it for SWEEP_STEP bins. Returns the number of elements reclaimed
+template<typename Type>
+bin_index_t Hash_table<Type>::expire(bin_index_t budget) {
+	if(this->expiry == nullptr)
+	{
+		return 0;
+	}
+	if(budget > this->array_size)
+	{
+		budget = this->array_size;
+	}
+	bin_index_t reclaimed = 0;
+	for(bin_index_t i = 0; i < budget; i++)
+	{
+		bin_index_t n = this->sweeper;
+		this->sweeper = (this->sweeper + 1) & this->mask;
+		if(this->occupied[n] == OCCUPIED && this->expired(this->expiry[n]))
+		{
+			this->reclaim(n);
+			reclaimed++;
+		}
+	}
+	//Reclaimed bins are erased bins; rehash once they would make probe sequences long
+	if(this->empty_bin >= this->array_size / 4)
+	{
+		this->rehash(this->power);
+	}
+	else if(this->filter != nullptr && this->filter_erased >= this->array_size / 4)
+	{
+		this->rebuild_filter();
+	}
+	return reclaimed;
+}
+
+//Returns true if an element with expiry time t has expired
+template<typename Type>
+bool Hash_table<Type>::expired(unsigned int t) const {
+	return(static_cast<int>(t - this->now) <= 0);
+}
+
+//Returns true if bin n holds an element that has not expired
+template<typename Type>
+bool Hash_table<Type>::live(bin_index_t n) const {
+	return(this->occupied[n] == OCCUPIED && (this->expiry == nullptr || !this->expired(this->expiry[n])));
+}
+
+//Returns the number of elements that have not expired. Outside TTL mode this is count;
+//in TTL mode count still includes expired elements that have not been reclaimed, so the bins are scanned
+template<typename Type>
+bin_index_t Hash_table<Type>::live_count() const {
+	if(this->expiry == nullptr)
+	{
+		return this->count;
+	}
+	bin_index_t n = 0;
+	for(bin_index_t i = 0; i < this->array_size; i++)
+	{
+		if(this->live(i))
+		{
+			n++;
+		}
+	}
+	return n;
+}
+
+//Bloom filter
+//The filter holds roughly 8 bits per bin and is kept in step by insert(), erase() and clear()
+template<typename Type>
+void Hash_table<Type>::enable_filter() {
+	if(this->filter == nullptr)
+	{
+		this->filter = new Bloom_filter(this->array_size);
+		this->rebuild_filter();
+	}
+	return;
+}
+
+template<typename Type>
+void Hash_table<Type>::disable_filter() {
+	delete this->filter;
+	this->filter = nullptr;
+	this->filter_erased = 0;
+	return;
+}
+
+//Clear the filter and add back every occupied bin, dropping the bits left by erased keys
+template<typename Type>
+void Hash_table<Type>::rebuild_filter() {
+	if(this->filter == nullptr)
+	{
+		return;
+	}
+	this->filter->clear();
+	for(bin_index_t i = 0; i < this->array_size; i++)
+	{
+		if(this->occupied[i] == OCCUPIED)
+		{
+			this->filter->add(this->fingerprint(this->array[i]));
+		}
+	}
+	this->filter_erased = 0;
+	return;
+}
+
+//Set algebra
+//Empties the table and, if it differs, switches to a capacity of 2^m bins
+template<typename Type>
+void Hash_table<Type>::reset(int m) {
+	this->clear();
+	if(m != this->power)
+	{
+		Type *new_array = allocate_bins(static_cast<bin_index_t>(1) << m);
+		bin_state_t *new_occupied = new bin_state_t[static_cast<bin_index_t>(1) << m];
+		delete[] this->occupied;
+		deallocate_bins(this->array);
+		this->array = new_array;
+		this->occupied = new_occupied;
+		if(this->referenced != nullptr)
+		{
+			delete[] this->referenced;
+			this->referenced = new unsigned char[static_cast<bin_index_t>(1) << m];
+			this->scale_cache_limit(m);
+		}
+		if(this->expiry != nullptr)
+		{
+			delete[] this->expiry;
+			this->expiry = new unsigned int[static_cast<bin_index_t>(1) << m];
+		}
+		this->power = m;
+		this->array_size = static_cast<bin_index_t>(1) << m;
+		this->mask = this->array_size - 1;
+		//The new bins hold no elements; clear() below must not destroy any
+		for(bin_index_t i = 0; i < this->array_size; i++)
+		{
+			this->occupied[i] = UNOCCUPIED;
+		}
+		if(this->filter != nullptr)
+		{
+			delete this->filter;
+			this->filter = new Bloom_filter(this->array_size);
+		}
+	}
+	this->clear();
+	return;
+}
+
+//Probes target for every live bin of source and returns the number of hits; the number of
+//live bins of source is stored in probed.
+//If hit is not nullptr, hit[i] is set to 1 for bin i of source when its key is in target, 0 otherwise.
+//Bins are handled in batches: the home bins of a whole batch are prefetched before any of
+//them is probed, so the cache misses overlap. Under OpenMP the bin ranges run in parallel
+template<typename Type>
+bin_index_t Hash_table<Type>::probe_bins(Hash_table const &source, Hash_table const &target, unsigned char *hit, bin_index_t &probed) {
+	const int BATCH = 16;
+	bin_index_t hits = 0;
+	bin_index_t sources = 0;
+
+#if defined(_OPENMP)
+	#pragma omp parallel for reduction(+:hits,sources) schedule(static)
+#endif
+	for(bin_index_t start = 0; start < source.array_size; start += BATCH)
+	{
+		bin_index_t end = (start + BATCH < source.array_size) ? start + BATCH : source.array_size;
+		for(bin_index_t i = start; i < end; i++)
+		{
+			if(source.live(i))
+			{
+				target.prefetch(source.array[i]);
+				sources++;
+			}
+		}
+		for(bin_index_t i = start; i < end; i++)
+		{
+			//locate() rather than member(), which may reclaim bins and so cannot run in parallel
+			bin_index_t n = source.live(i) ? target.locate(source.array[i]) : -1;
+			bool found = (n >= 0 && target.live(n));
+			if(found)
+			{
+				hits++;
+			}
+			if(hit != nullptr)
+			{
+				hit[i] = found ? 1 : 0;
+			}
+		}
+	}
+	probed = sources;
+	return hits;
+}
+
+//Stores the keys in both tables in result, which is cleared and presized first.
+//The smaller table is walked and the larger one probed
+template<typename Type>
+void Hash_table<Type>::intersect(Hash_table const &other, Hash_table &result) const {
+	if(&result == this || &result == &other)
+	{
+		throw illegal_argument();
+	}
+	Hash_table const &small = (this->count <= other.count) ? *this : other;
+	Hash_table const &large = (this->count <= other.count) ? other : *this;
+
+	unsigned char *hit = new unsigned char[small.array_size];
+	bin_index_t probed;
+	bin_index_t hits = probe_bins(small, large, hit, probed);
+	result.reset(power_for(hits));
+	for(bin_index_t i = 0; i < small.array_size; i++)
+	{
+		if(hit[i])
+		{
+			result.insert_new(small.array[i]);
+		}
+	}
+	delete[] hit;
+	return;
+}
+
+//Stores the keys in either table in result, which is cleared and presized first.
+//The larger table is copied, then the keys of the smaller one it does not hold are added
+template<typename Type>
+void Hash_table<Type>::unite(Hash_table const &other, Hash_table &result) const {
+	if(&result == this || &result == &other)
+	{
+		throw illegal_argument();
+	}
+	Hash_table const &small = (this->count <= other.count) ? *this : other;
+	Hash_table const &large = (this->count <= other.count) ? other : *this;
+
+	unsigned char *hit = new unsigned char[small.array_size];
+	bin_index_t probed;
+	bin_index_t hits = probe_bins(small, large, hit, probed);
+	result.reset(power_for(large.live_count() + probed - hits));
+	for(bin_index_t i = 0; i < large.array_size; i++)
+	{
+		if(large.live(i))
+		{
+			result.insert_new(large.array[i]);
+		}
+	}
+	for(bin_index_t i = 0; i < small.array_size; i++)
+	{
+		if(small.live(i) && !hit[i])
+		{
+			result.insert_new(small.array[i]);
+		}
+	}
+	delete[] hit;
+	return;
+}
+
+//Stores the keys of this table that are not in other in result, which is cleared and presized first
+template<typename Type>
+void Hash_table<Type>::subtract(Hash_table const &other, Hash_table &result) const {
+	if(&result == this || &result == &other)
+	{
+		throw illegal_argument();
+	}
+	unsigned char *hit = new unsigned char[this->array_size];
+	bin_index_t probed;
+	bin_index_t hits = probe_bins(*this, other, hit, probed);
+	result.reset(power_for(probed - hits));
+	for(bin_index_t i = 0; i < this->array_size; i++)
+	{
+		if(this->live(i) && !hit[i])
+		{
+			result.insert_new(this->array[i]);
+		}
+	}
+	delete[] hit;
+	return;
+}
+
+//Returns true if every key of this table is in other. Expired elements of either table are
+//left out, so the early answer from the counts is only taken when this table has no expiry
+template<typename Type>
+bool Hash_table<Type>::is_subset(Hash_table const &other) const {
+	if(this->expiry == nullptr && this->count > other.count)
+	{
+		return false;
+	}
+	bin_index_t probed;
+	bin_index_t hits = probe_bins(*this, other, nullptr, probed);
+	return(hits == probed);
+}
+
 template <typename T>
 std::ostream &operator<<( std::ostream &out, Hash_table<T> const &hash ) {
-	for ( int i = 0; i < hash.capacity(); ++i ) {
+	for ( bin_index_t i = 0; i < hash.capacity(); ++i ) {
 		if ( hash.occupied[i] == UNOCCUPIED ) {
 			out << "- ";
 		} else if ( hash.occupied[i] == ERASED ) {
@@ -0,0 +1,37 @@
+#include <iostream>
+#include <cstring>
+#include <cstdlib>
+#include "Hash_Table_Benchmark.h"
+
+int main(int argc, char *argv[]) {
+	if(argc < 2) {
+		std::cerr << "Usage: " << argv[0] << " large [power] | scaling [base_power] | frozen [max_power]" << std::endl;
+
+		return -1;
+	}
+
+	if(!std::strcmp(argv[1], "large")) {
+		//2^32 bins by default, so that bin numbers and counts pass 2^31
+		int power = (argc > 2) ? std::atoi(argv[2]) : 32;
+
+		return large_table_test(power, std::cout) ? 0 : 1;
+	}
+
+	if(!std::strcmp(argv[1], "scaling")) {
+		//Tables of 2^14 up to 2^22 bins by default
+		int base_power = (argc > 2) ? std::atoi(argv[2]) : 14;
+
+		return scaling_test(base_power, std::cout) ? 0 : 1;
+	}
+
+	if(!std::strcmp(argv[1], "frozen")) {
+		//Up to 2^24 keys by default, where a build at load factor 1 used to stall
+		int max_power = (argc > 2) ? std::atoi(argv[2]) : 24;
+
+		return frozen_build_test(max_power, std::cout) ? 0 : 1;
+	}
+
+	std::cerr << argv[1] << ": unknown benchmark" << std::endl;
+
+	return -1;
+}
@@ -0,0 +1,517 @@
+#ifndef HASH_TABLE_BENCHMARK_H
+#define HASH_TABLE_BENCHMARK_H
+
+#include "Hash_Table.h"
+#include "Frozen_Hash_Table.h"
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cmath>
+
+//Scrambles i into a well-spread 63-bit value; doubling it gives the n-th key of a test,
+//and doubling it plus one gives a key that is guaranteed not to be in the table
+inline long long benchmark_key( long long i ) {
+	return static_cast<long long>( splitmix64( static_cast<unsigned long long>( i ) + 0x9E3779B97F4A7C15ULL ) >> 2 );
+}
+
+//Large-table test
+//Builds a table of 2^power bins, fills it to a load factor of 3/4 with spread-out keys,
+//checks that every key is found, that absent keys are not, and that erase and reinsert
+//work across the whole range, and reports the time per operation.
+//Bin numbers beyond 2^31 are only reached with power >= 32 (about 36 GiB of bins).
+//Returns true if every check passed
+inline bool large_table_test( int power, std::ostream &out ) {
+	mem_alloc::Stopwatch watch;
+	Hash_table<long long> table( power );
+	bin_index_t n = table.capacity() - table.capacity()/4;
+	bool passed = true;
+
+	out << "Large table: 2^" << power << " = " << table.capacity() << " bins, " << n << " keys" << std::endl;
+
+	watch.start();
+	for ( bin_index_t i = 0; i < n; ++i ) {
+		table.insert( 2*benchmark_key( i ) );
+	}
+	watch.stop();
+	out << "  insert:      " << 1e9*watch.get_last_duration()/n << " ns/op" << std::endl;
+
+	if ( table.size() != n ) {
+		out << "  FAILED size(): expecting " << n << " but got " << table.size() << std::endl;
+		passed = false;
+	}
+
+	bin_index_t found = 0;
+	watch.start();
+	for ( bin_index_t i = 0; i < n; ++i ) {
+		found += table.member( 2*benchmark_key( i ) ) ? 1 : 0;
+	}
+	watch.stop();
+	out << "  member hit:  " << 1e9*watch.get_last_duration()/n << " ns/op" << std::endl;
+
+	if ( found != n ) {
+		out << "  FAILED member(): " << n - found << " inserted keys were not found" << std::endl;
+		passed = false;
+	}
+
+	found = 0;
+	watch.start();
+	for ( bin_index_t i = 0; i < n; ++i ) {
+		found += table.member( 2*benchmark_key( i ) + 1 ) ? 1 : 0;
+	}
+	watch.stop();
+	out << "  member miss: " << 1e9*watch.get_last_duration()/n << " ns/op" << std::endl;
+
+	if ( found != 0 ) {
+		out << "  FAILED member(): " << found << " absent keys were found" << std::endl;
+		passed = false;
+	}
+
+	//Erase every other key, then check the survivors and reinsert
+	bin_index_t erased = 0;
+	watch.start();
+	for ( bin_index_t i = 0; i < n; i += 2 ) {
+		erased += table.erase( 2*benchmark_key( i ) ) ? 1 : 0;
+	}
+	watch.stop();
+	out << "  erase:       " << 1e9*watch.get_last_duration()/((n + 1)/2) << " ns/op" << std::endl;
+
+	for ( bin_index_t i = 0; i < n; ++i ) {
+		if ( table.member( 2*benchmark_key( i ) ) != (i % 2 == 1) ) {
+			out << "  FAILED member() after erase for key number " << i << std::endl;
+			passed = false;
+			break;
+		}
+	}
+
+	for ( bin_index_t i = 0; i < n; i += 2 ) {
+		table.insert( 2*benchmark_key( i ) );
+	}
+
+	if ( erased != (n + 1)/2 || table.size() != n ) {
+		out << "  FAILED erase()/insert(): expecting " << n << " keys after reinsertion but got " << table.size() << std::endl;
+		passed = false;
+	}
+
+	out << (passed ? "  Okay" : "  FAILED") << std::endl;
+
+	return passed;
+}
+
+//Complexity-regression suite
+//Operations timed by scaling_time(); clear() is measured per bin since it is O(capacity)
+enum scaling_op_t { SCALE_INSERT, SCALE_MEMBER_HIT, SCALE_MEMBER_MISS, SCALE_ERASE, SCALE_TOMBSTONE_MISS, SCALE_CLEAR, SCALE_OPS };
+
+static const char *const scaling_op_name[SCALE_OPS] = {
+	"insert", "member hit", "member miss", "erase", "miss w/ erased bins", "clear"
+};
+
+//Minimum timed duration per measurement; rounds are repeated until it is reached
+static const double SCALING_MIN_SECONDS = 0.02;
+
+//Measurements per operation and table size; the median is kept, so that a single slow
+//measurement (a context switch, a page fault burst) does not fail the suite
+static const int SCALING_SAMPLES = 5;
+
+//Largest allowed growth of the normalized cost from the smallest to the largest table, along
+//the line fitted by scaling_drift(). A cost of O(log n) per operation grows by 22/14, about 1.6,
+//from 2^14 to 2^22 bins, so it fails
+static const double SCALING_MAX_DRIFT = 1.4;
+
+//Returns the average time per operation, in seconds, of op on a table of 2^power bins holding n keys
+//(for SCALE_CLEAR, the time per bin of clear()).
+//Each round builds the table untimed and times one batch of n operations
+inline double scaling_time( scaling_op_t op, int power, bin_index_t n ) {
+	mem_alloc::Stopwatch watch;
+	double total = 0.0;
+	double total_ops = 0.0;
+	bin_index_t found = 0;
+
+	for ( int round = 0; round < 1 || total < SCALING_MIN_SECONDS; ++round ) {
+		Hash_table<long long> table( power );
+		bin_index_t ops = n;
+
+		if ( op != SCALE_INSERT ) {
+			for ( bin_index_t i = 0; i < n; ++i ) {
+				table.insert( 2*benchmark_key( i ) );
+			}
+		}
+
+		if ( op == SCALE_TOMBSTONE_MISS ) {
+			//Erase half of the keys and insert as many new ones, leaving erased bins on the probe sequences
+			for ( bin_index_t i = 0; i < n; i += 2 ) {
+				table.erase( 2*benchmark_key( i ) );
+			}
+
+			for ( bin_index_t i = 0; i < n; i += 2 ) {
+				table.insert( 2*benchmark_key( n + i ) );
+			}
+		}
+
+		watch.start();
+
+		switch ( op ) {
+			case SCALE_INSERT:
+				for ( bin_index_t i = 0; i < n; ++i ) {
+					table.insert( 2*benchmark_key( i ) );
+				}
+				break;
+			case SCALE_MEMBER_HIT:
+				for ( bin_index_t i = 0; i < n; ++i ) {
+					found += table.member( 2*benchmark_key( i ) ) ? 1 : 0;
+				}
+				break;
+			case SCALE_MEMBER_MISS:
+			case SCALE_TOMBSTONE_MISS:
+				for ( bin_index_t i = 0; i < n; ++i ) {
+					found += table.member( 2*benchmark_key( i ) + 1 ) ? 1 : 0;
+				}
+				break;
+			case SCALE_ERASE:
+				for ( bin_index_t i = 0; i < n; ++i ) {
+					found += table.erase( 2*benchmark_key( i ) ) ? 1 : 0;
+				}
+				break;
+			case SCALE_CLEAR:
+				//The first call clears the full table, the rest an already empty one
+				ops = 16*table.capacity();
+				for ( int i = 0; i < 16; ++i ) {
+					table.clear();
+				}
+				break;
+			default:
+				break;
+		}
+
+		watch.stop();
+
+		total += watch.get_last_duration();
+		total_ops += ops;
+	}
+
+	//Keep the loops from being optimized away
+	if ( found < 0 ) {
+		std::cout << found;
+	}
+
+	return total/total_ops;
+}
+
+//Bin states of the plain open-addressed table that scaling_baseline() times
+enum reference_state_t : unsigned char { REFERENCE_EMPTY, REFERENCE_FULL, REFERENCE_ERASED };
+
+//Returns the bin of key in the plain table, or -1, walking the probe sequence as
+//Hash_table::locate() does
+inline bin_index_t reference_find( long long const *keys, unsigned char const *states, bin_index_t size, long long key ) {
+	bin_index_t probe = key % size;
+	bin_index_t offset = 1;
+
+	for ( bin_index_t counter = size; counter > 0 && states[probe] != REFERENCE_EMPTY; --counter ) {
+		if ( states[probe] == REFERENCE_FULL && keys[probe] == key ) {
+			return probe;
+		}
+
+		probe = (probe + offset) & (size - 1);
+		offset += 1;
+	}
+
+	return -1;
+}
+
+//Adds key to the plain table, if it is absent, in the first bin of its probe sequence that is
+//not full, as Hash_table::insert() does
+inline void reference_insert( long long *keys, unsigned char *states, bin_index_t size, long long key ) {
+	if ( reference_find( keys, states, size, key ) >= 0 ) {
+		return;
+	}
+
+	bin_index_t probe = key % size;
+	bin_index_t offset = 1;
+
+	while ( states[probe] == REFERENCE_FULL ) {
+		probe = (probe + offset) & (size - 1);
+		offset += 1;
+	}
+
+	keys[probe] = key;
+	states[probe] = REFERENCE_FULL;
+}
+
+//Returns the average time, in seconds, of op done by hand on a plain open-addressed table of
+//2^power bins, a key array and a state array (for SCALE_CLEAR, of writing one bin state in a
+//linear pass). It is filled with the same keys by the same hash and probe sequence as the
+//Hash_table of scaling_time(), so op makes the same dependent bin accesses. Dividing by it
+//factors out how the memory hierarchy slows down larger tables and how the probe sequences
+//lengthen with the load, which a single random access per operation does not: the normalized
+//cost of a constant-cost operation then stays flat instead of falling as the tables grow and
+//hiding a slowly growing cost
+inline double scaling_baseline( scaling_op_t op, int power, bin_index_t n ) {
+	mem_alloc::Stopwatch watch;
+	bin_index_t size = static_cast<bin_index_t>( 1 ) << power;
+	long long *keys = new long long[size];
+	unsigned char *states = new unsigned char[size];
+	double total = 0.0;
+	double total_ops = 0.0;
+	long long sum = 0;
+
+	for ( int round = 0; round < 1 || total < SCALING_MIN_SECONDS; ++round ) {
+		bin_index_t ops = n;
+
+		std::fill( states, states + size, static_cast<unsigned char>( REFERENCE_EMPTY ) );
+
+		if ( op != SCALE_INSERT && op != SCALE_CLEAR ) {
+			for ( bin_index_t i = 0; i < n; ++i ) {
+				reference_insert( keys, states, size, 2*benchmark_key( i ) );
+			}
+		}
+
+		if ( op == SCALE_TOMBSTONE_MISS ) {
+			for ( bin_index_t i = 0; i < n; i += 2 ) {
+				states[reference_find( keys, states, size, 2*benchmark_key( i ) )] = REFERENCE_ERASED;
+			}
+
+			for ( bin_index_t i = 0; i < n; i += 2 ) {
+				reference_insert( keys, states, size, 2*benchmark_key( n + i ) );
+			}
+		}
+
+		watch.start();
+
+		switch ( op ) {
+			case SCALE_INSERT:
+				for ( bin_index_t i = 0; i < n; ++i ) {
+					reference_insert( keys, states, size, 2*benchmark_key( i ) );
+				}
+				break;
+			case SCALE_MEMBER_HIT:
+				for ( bin_index_t i = 0; i < n; ++i ) {
+					sum += reference_find( keys, states, size, 2*benchmark_key( i ) ) >= 0 ? 1 : 0;
+				}
+				break;
+			case SCALE_MEMBER_MISS:
+			case SCALE_TOMBSTONE_MISS:
+				for ( bin_index_t i = 0; i < n; ++i ) {
+					sum += reference_find( keys, states, size, 2*benchmark_key( i ) + 1 ) >= 0 ? 1 : 0;
+				}
+				break;
+			case SCALE_ERASE:
+				for ( bin_index_t i = 0; i < n; ++i ) {
+					bin_index_t b = reference_find( keys, states, size, 2*benchmark_key( i ) );
+
+					if ( b >= 0 ) {
+						states[b] = REFERENCE_ERASED;
+						++sum;
+					}
+				}
+				break;
+			case SCALE_CLEAR:
+				ops = 16*size;
+				for ( int j = 0; j < 16; ++j ) {
+					for ( bin_index_t i = 0; i < size; ++i ) {
+						states[i] = static_cast<unsigned char>( j );
+					}
+					sum += states[size - 1 - j];
+				}
+				break;
+			default:
+				break;
+		}
+
+		watch.stop();
+
+		total += watch.get_last_duration();
+		total_ops += ops;
+	}
+
+	if ( sum == 42 ) {
+		std::cout << "";
+	}
+
+	delete[] states;
+	delete[] keys;
+
+	return total/total_ops;
+}
+
+//Returns the median over SCALING_SAMPLES measurements of the cost of op in units of the
+//baseline; each measurement times the operation and its baseline back to back
+inline double scaling_cost( scaling_op_t op, int power, bin_index_t n ) {
+	double samples[SCALING_SAMPLES];
+
+	for ( int s = 0; s < SCALING_SAMPLES; ++s ) {
+		samples[s] = scaling_time( op, power, n )/scaling_baseline( op, power, n );
+	}
+
+	std::sort( samples, samples + SCALING_SAMPLES );
+
+	return samples[SCALING_SAMPLES/2];
+}
+
+//Returns the growth of the least-squares line through the costs of the levels, from the first
+//level to the last: its value at the last over its value at the first. One slow or fast
+//measurement at either end moves it much less than the ratio of the last cost to the first
+inline double scaling_drift( double const *cost, int levels ) {
+	double mean_level = (levels - 1)/2.0;
+	double mean_cost = 0.0;
+
+	for ( int level = 0; level < levels; ++level ) {
+		mean_cost += cost[level]/levels;
+	}
+
+	double covariance = 0.0;
+	double variance = 0.0;
+
+	for ( int level = 0; level < levels; ++level ) {
+		covariance += (level - mean_level)*(cost[level] - mean_cost);
+		variance += (level - mean_level)*(level - mean_level);
+	}
+
+	double first = mean_cost - covariance/variance*mean_level;
+	double last = mean_cost + covariance/variance*mean_level;
+
+	//A line that rises from zero or below has grown without bound
+	if ( first <= 0.0 ) {
+		return (last > first) ? HUGE_VAL : 1.0;
+	}
+
+	return last/first;
+}
+
+//Times every operation over LEVELS table sizes that grow by a factor of 2^K, for load
+//factors 1/4, 1/2 and 3/4. The cost of each operation is measured in units of the same
+//operation on a plain open-addressed table of the same size and load (one linear bin write
+//for clear()), and is expected to stay constant. An operation fails if
+//mem_alloc::asymptotic_tester finds its total cost growing faster than n log n, or if the line
+//fitted through its median costs grows by more than SCALING_MAX_DRIFT from the smallest table
+//to the largest.
+//base_power is the capacity of the smallest table. Returns true if every check passed
+inline bool scaling_test( int base_power, std::ostream &out ) {
+	const int LEVELS = 5;
+	const int K = 2;
+	const int LOADS = 3;
+	const int load_quarters[LOADS] = { 1, 2, 3 };
+
+	bool passed = true;
+	double cost[LEVELS];
+	double totals[LEVELS];
+
+	out << "Cost per operation relative to a plain open-addressed table (clear: to bin writes), 2^"
+	    << base_power << " to 2^" << base_power + K*(LEVELS - 1) << " bins" << std::endl;
+
+	for ( int l = 0; l < LOADS; ++l ) {
+		out << "Load factor " << load_quarters[l] << "/4" << std::endl;
+
+		for ( int op = 0; op < SCALE_OPS; ++op ) {
+			out << "  " << std::setw( 20 ) << std::left << scaling_op_name[op] << std::right;
+
+			for ( int level = 0; level < LEVELS; ++level ) {
+				int power = base_power + K*level;
+				bin_index_t n = (static_cast<bin_index_t>( 1 ) << power)*load_quarters[l]/4;
+
+				cost[level] = scaling_cost( static_cast<scaling_op_t>( op ), power, n );
+
+				//asymptotic_tester expects the total for 2*2^(K*level) operations
+				totals[level] = cost[level]*(2 << (K*level));
+
+				out << std::setw( 8 ) << std::fixed << std::setprecision( 2 ) << cost[level];
+			}
+
+			bool growth = mem_alloc::asymptotic_tester( totals, LEVELS, K, true );
+			bool drift = scaling_drift( cost, LEVELS ) <= SCALING_MAX_DRIFT;
+
+			if ( growth && drift ) {
+				out << "  Okay" << std::endl;
+			} else {
+				out << "  FAILED: cost per operation grows with the table size" << std::endl;
+				passed = false;
+			}
+		}
+	}
+
+	out.unsetf( std::ios::fixed );
+
+	return passed;
+}
+
+//Frozen_hash_table build test
+//Largest allowed growth of the build time per key from 2^16 keys to the largest set. The build
+//does a constant number of random slot probes per key, but still slows down as its working set
+//leaves the caches: about 2x up to 2^24 keys and 3.5x up to 2^26. Every reseed repeats the
+//whole build, and a pilot search that runs out of pilots reseeds
+static const double FROZEN_MAX_DRIFT = 6.0;
+
+//Builds Frozen_hash_tables of 2^16, 2^18, ... up to 2^max_power keys, checks every lookup and
+//times the build. The test fails if the build time per key grows by more than FROZEN_MAX_DRIFT
+//from the smallest set to the largest, or if the build throws.
+//Returns true if every check passed
+inline bool frozen_build_test( int max_power, std::ostream &out ) {
+	const int MIN_POWER = 16;
+
+	mem_alloc::Stopwatch watch;
+	bool passed = true;
+	double first_cost = 0.0;
+	double last_cost = 0.0;
+
+	out << "Frozen_hash_table build, 2^" << MIN_POWER << " to 2^" << max_power << " keys" << std::endl;
+
+	for ( int power = MIN_POWER; power <= max_power; power += 2 ) {
+		bin_index_t n = static_cast<bin_index_t>( 1 ) << power;
+		Hash_table<long long> table( power + 1 );
+
+		for ( bin_index_t i = 0; i < n; ++i ) {
+			table.insert( 2*benchmark_key( i ) );
+		}
+
+		Frozen_hash_table<long long> *frozen = nullptr;
+
+		watch.start();
+		try {
+			frozen = new Frozen_hash_table<long long>( table );
+		} catch ( overflow ) {
+			watch.stop();
+			out << "  2^" << power << " keys: FAILED, no pilots found" << std::endl;
+			passed = false;
+			break;
+		}
+		watch.stop();
+
+		double seconds = watch.get_last_duration();
+		double cost = seconds/n;
+
+		bin_index_t found = 0;
+		bin_index_t false_hits = 0;
+
+		for ( bin_index_t i = 0; i < n; ++i ) {
+			found += frozen->member( 2*benchmark_key( i ) ) ? 1 : 0;
+			false_hits += frozen->member( 2*benchmark_key( i ) + 1 ) ? 1 : 0;
+		}
+
+		out << "  2^" << std::setw( 2 ) << power << " keys: " << std::setw( 8 ) << seconds << " s, "
+		    << 1e9*cost << " ns/key, "
+		    << static_cast<double>( frozen->memory_bytes() )/n << " bytes/key" << std::endl;
+
+		if ( found != n || false_hits != 0 || frozen->size() != n ) {
+			out << "  FAILED member(): " << n - found << " keys missing, " << false_hits << " absent keys found" << std::endl;
+			passed = false;
+		}
+
+		delete frozen;
+
+		if ( power == MIN_POWER ) {
+			first_cost = cost;
+		}
+
+		last_cost = cost;
+	}
+
+	if ( passed && last_cost > FROZEN_MAX_DRIFT*first_cost ) {
+		out << "  FAILED: build cost per key grows with the number of keys" << std::endl;
+		passed = false;
+	}
+
+	out << (passed ? "  Okay" : "  FAILED") << std::endl;
+
+	return passed;
+}
+
+#endif
@@ -10,6 +10,8 @@
 #include "Hash_Table.h"
 
 #include <iostream>
+#include <string>
+#include <utility>
 
 
 template <typename Type>
@@ -17,12 +19,19 @@ class Hash_table_tester:public test< Hash_table<Type> > {
 	using test< Hash_table<Type> >::object;
 	using test< Hash_table<Type> >::command;
 
+	private:
+		Hash_table<Type> *other;	//Second operand of the set operations
+
 	public:
 		Hash_table_tester(Hash_table<Type> *obj =
-0 ):test< Hash_table<Type> >(obj){
+0 ):test< Hash_table<Type> >(obj), other(nullptr ){
 			//empty
 		}
 
+		~Hash_table_tester(){
+			delete other;
+		}
+
 		void process();
 };
 
@@ -39,11 +48,11 @@ void Hash_table_tester<Type>::process() {
 	} else if(command == "size"){
 		//Check if the size equals the next integer read
 
-		int expected_size;
+		bin_index_t expected_size;
 
 		std::cin >> expected_size;
 
-		int actual_size = object->size();
+		bin_index_t actual_size = object->size();
 
 		if(actual_size == expected_size){
 			std::cout << "Okay" << std::endl;
@@ -53,11 +62,11 @@ void Hash_table_tester<Type>::process() {
 	} else if(command == "capacity"){
 		//Check if the capacity equals the next integer read
 
-		int expected_capacity;
+		bin_index_t expected_capacity;
 
 		std::cin >> expected_capacity;
 
-		int actual_capacity = object->capacity();
+		bin_index_t actual_capacity = object->capacity();
 
 		if(actual_capacity == expected_capacity){
 			std::cout << "Okay" << std::endl;
@@ -111,7 +120,7 @@ void Hash_table_tester<Type>::process() {
 	} else if(command == "bin"){
 		//Check the element in the specified bin
 
-		int n;
+		bin_index_t n;
 		Type expected_value;
 
 		std::cin >> n;
@@ -148,6 +157,30 @@ void Hash_table_tester<Type>::process() {
                 } catch (...) {
                         std::cout << "Failed insert(" << n << "): expecting an overflow exception but caught a different exception" << std::endl;
                 }
+	} else if(command == "emplace"){
+		//Construct an element from the next value read in the hash table
+
+		Type n;
+
+		std::cin >> n;
+
+		object->emplace(n );
+		std::cout << "Okay" << std::endl;
+	} else if(command == "emplace!"){
+		//Cannot emplace due to the table being full
+
+		Type n;
+
+		std::cin >> n;
+
+		try {
+			object->emplace(n );
+			std::cout << "Failed emplace(" << n << "): expecting to catch an exception but did not" << std::endl;
+		} catch(overflow){
+			std::cout << "Okay" << std::endl;
+		} catch (...) {
+			std::cout << "Failed emplace(" << n << "): expecting an overflow exception but caught a different exception" << std::endl;
+		}
 	} else if(command == "erase"){
 		//Check the element in the specified bin
 
@@ -168,6 +201,354 @@ void Hash_table_tester<Type>::process() {
 		object->clear();
 
 		std::cout << "Okay" << std::endl;
+	} else if(command == "reserve"){
+		bin_index_t n;
+
+		std::cin >> n;
+
+		object->reserve(n );
+		std::cout << "Okay" << std::endl;
+	} else if(command == "reserve!"){
+		//Cannot reserve a negative number of elements (illegal_argument) or more than the
+		//largest table holds (overflow)
+
+		bin_index_t n;
+
+		std::cin >> n;
+
+		try {
+			object->reserve(n );
+			std::cout << "Failed reserve(" << n << "): expecting to catch an exception but did not" << std::endl;
+		} catch(illegal_argument){
+			if(n < 0){
+				std::cout << "Okay" << std::endl;
+			} else {
+				std::cout << "Failed reserve(" << n << "): expecting an overflow exception but caught an illegal_argument exception" << std::endl;
+			}
+		} catch(overflow){
+			if(n >= 0){
+				std::cout << "Okay" << std::endl;
+			} else {
+				std::cout << "Failed reserve(" << n << "): expecting an illegal_argument exception but caught an overflow exception" << std::endl;
+			}
+		} catch (...) {
+			std::cout << "Failed reserve(" << n << "): expecting an exception but caught a different exception" << std::endl;
+		}
+	} else if(command == "erase_if_less" || command == "retain_if_less"){
+		//Erase the elements less than (erase_if) or not less than (retain_if) the next value
+		//read, and check how many were removed
+
+		Type n;
+		bin_index_t expected_removed;
+
+		std::cin >> n;
+		std::cin >> expected_removed;
+
+		auto less = [n](Type const &x ){ return x < n; };
+
+		bin_index_t actual_removed = (command == "erase_if_less") ? object->erase_if(less ) : object->retain_if(less );
+
+		if(actual_removed == expected_removed){
+			std::cout << "Okay" << std::endl;
+		} else {
+			std::cout << ": Failed " << command << "(" << n << "): expecting the value '" << expected_removed << "' but got '" << actual_removed << "'" << std::endl;
+		}
+	} else if(command == "erase_if_throw"){
+		//Erase every element with a predicate that throws at the next value read, and check
+		//that the exception is passed on and that size still counts the occupied bins
+
+		Type n;
+
+		std::cin >> n;
+
+		bool caught = false;
+
+		try {
+			object->erase_if([n](Type const &x ){
+				if(x == n){
+					throw illegal_argument();
+				}
+
+				return true;
+			} );
+		} catch(illegal_argument){
+			caught = true;
+		}
+
+		bin_index_t occupied_bins = 0;
+
+		for(bin_index_t i = 0; i < object->capacity(); ++i){
+			if(object->occupied[i] == OCCUPIED){
+				++occupied_bins;
+			}
+		}
+
+		if(!caught){
+			std::cout << ": Failed erase_if(" << n << "): expecting to catch an exception but did not" << std::endl;
+		} else if(object->size() != occupied_bins){
+			std::cout << ": Failed erase_if(" << n << "): size() is '" << object->size() << "' but " << occupied_bins << " bins are occupied" << std::endl;
+		} else {
+			std::cout << "Okay" << std::endl;
+		}
+	} else if(command == "shrink_to_fit"){
+		object->shrink_to_fit();
+
+		std::cout << "Okay" << std::endl;
+	} else if(command == "enable_filter"){
+		object->enable_filter();
+
+		std::cout << "Okay" << std::endl;
+	} else if(command == "filter_enabled"){
+		//Check if the Bloom filter is enabled
+
+		bool expected_enabled;
+
+		std::cin >> expected_enabled;
+
+		bool actual_enabled = (object->filter != nullptr);
+
+		if(actual_enabled == expected_enabled){
+			std::cout << "Okay" << std::endl;
+		} else {
+			std::cout << ": Failed filter_enabled: expecting the value '" << expected_enabled << "' but got '" << actual_enabled << "'" << std::endl;
+		}
+	} else if(command == "filter_may_contain"){
+		//Check whether the Bloom filter lets the element through to the probe sequence;
+		//the bits of an erased element stay set until the filter is rebuilt
+
+		Type n;
+		bool expected_contain;
+
+		std::cin >> n;
+		std::cin >> expected_contain;
+
+		bool actual_contain = (object->filter != nullptr && object->filter->may_contain(object->fingerprint(n ) ));
+
+		if(actual_contain == expected_contain){
+			std::cout << "Okay" << std::endl;
+		} else {
+			std::cout << ": Failed filter_may_contain(" << n << "): expecting the value '" << expected_contain << "' but got '" << actual_contain << "'" << std::endl;
+		}
+	} else if(command == "rebuild_filter"){
+		object->rebuild_filter();
+
+		std::cout << "Okay" << std::endl;
+	} else if(command == "disable_filter"){
+		object->disable_filter();
+
+		std::cout << "Okay" << std::endl;
+	} else if(command == "enable_cache"){
+		double load;
+
+		std::cin >> load;
+
+		object->enable_cache(load );
+		std::cout << "Okay" << std::endl;
+	} else if(command == "enable_cache!"){
+		//The target load is out of range
+
+		double load;
+
+		std::cin >> load;
+
+		try {
+			object->enable_cache(load );
+			std::cout << "Failed enable_cache(" << load << "): expecting to catch an exception but did not" << std::endl;
+		} catch(illegal_argument){
+			std::cout << "Okay" << std::endl;
+		} catch (...) {
+			std::cout << "Failed enable_cache(" << load << "): expecting an illegal_argument exception but caught a different exception" << std::endl;
+		}
+	} else if(command == "referenced"){
+		//Check the CLOCK reference bit of the bin holding the element
+
+		Type n;
+		bool expected_referenced;
+
+		std::cin >> n;
+		std::cin >> expected_referenced;
+
+		bin_index_t b = object->locate(n );
+
+		if(object->referenced == nullptr || b < 0){
+			std::cout << ": Failed referenced(" << n << "): the element is not in a cache" << std::endl;
+		} else if(static_cast<bool>(object->referenced[b] ) == expected_referenced){
+			std::cout << "Okay" << std::endl;
+		} else {
+			std::cout << ": Failed referenced(" << n << "): expecting the value '" << expected_referenced << "' but got '" << static_cast<bool>(object->referenced[b] ) << "'" << std::endl;
+		}
+	} else if(command == "disable_cache"){
+		object->disable_cache();
+
+		std::cout << "Okay" << std::endl;
+	} else if(command == "enable_ttl"){
+		unsigned int ttl;
+
+		std::cin >> ttl;
+
+		object->enable_ttl(ttl );
+		std::cout << "Okay" << std::endl;
+	} else if(command == "enable_ttl!" || command == "set_time!"){
+		//The lifetime is out of range, or the time is before the current time
+
+		unsigned int n;
+
+		std::cin >> n;
+
+		std::string function = (command == "enable_ttl!") ? "enable_ttl" : "set_time";
+
+		try {
+			if(command == "enable_ttl!"){
+				object->enable_ttl(n );
+			} else {
+				object->set_time(n );
+			}
+
+			std::cout << "Failed " << function << "(" << n << "): expecting to catch an exception but did not" << std::endl;
+		} catch(illegal_argument){
+			std::cout << "Okay" << std::endl;
+		} catch (...) {
+			std::cout << "Failed " << function << "(" << n << "): expecting an illegal_argument exception but caught a different exception" << std::endl;
+		}
+	} else if(command == "disable_ttl"){
+		object->disable_ttl();
+
+		std::cout << "Okay" << std::endl;
+	} else if(command == "set_time"){
+		unsigned int t;
+
+		std::cin >> t;
+
+		object->set_time(t );
+		std::cout << "Okay" << std::endl;
+	} else if(command == "expire"){
+		//Run the sweeper over n bins and check how many elements it reclaims
+
+		bin_index_t n;
+		bin_index_t expected_reclaimed;
+
+		std::cin >> n;
+		std::cin >> expected_reclaimed;
+
+		bin_index_t actual_reclaimed = object->expire(n );
+
+		if(actual_reclaimed == expected_reclaimed){
+			std::cout << "Okay" << std::endl;
+		} else {
+			std::cout << ": Failed expire(" << n << "): expecting the value '" << expected_reclaimed << "' but got '" << actual_reclaimed << "'" << std::endl;
+		}
+	} else if(command == "other:"){
+		//Replace the second operand by an empty table of 2^n bins
+
+		int n;
+
+		std::cin >> n;
+
+		delete other;
+		other = new Hash_table<Type>(n );
+		std::cout << "Okay" << std::endl;
+	} else if(command == "insert_other"){
+		Type n;
+
+		std::cin >> n;
+
+		other->insert(n );
+		std::cout << "Okay" << std::endl;
+	} else if(command == "swap_other"){
+		//Exchange the object and the second operand, to run an operation the other way around
+
+		Hash_table<Type> *tmp = object;
+
+		object = other;
+		other = tmp;
+		std::cout << "Okay" << std::endl;
+	} else if(command == "copy" || command == "copy_compact" || command == "move"){
+		//Replace the object by a copy of it (compacting with copy_compact) or by a table
+		//its bins are moved into, and destroy the original
+
+		Hash_table<Type> *result;
+
+		if(command == "copy"){
+			result = new Hash_table<Type>(*object );
+		} else if(command == "copy_compact"){
+			result = new Hash_table<Type>(*object, true );
+		} else {
+			result = new Hash_table<Type>(std::move(*object ) );
+		}
+
+		delete object;
+		object = result;
+		std::cout << "Okay" << std::endl;
+	} else if(command == "assign_other"){
+		//Copy assign the object to the second operand
+
+		*other = *object;
+		std::cout << "Okay" << std::endl;
+	} else if(command == "move_other"){
+		//Move assign the object to the second operand, which then replaces the object;
+		//the second operand becomes a new, empty table
+
+		*other = std::move(*object );
+
+		delete object;
+		object = other;
+		other = new Hash_table<Type>();
+		std::cout << "Okay" << std::endl;
+	} else if(command == "move_from_other"){
+		//Replace the object by a table the second operand is moved into; the second operand
+		//is kept, left empty
+
+		Hash_table<Type> *result = new Hash_table<Type>(std::move(*other ) );
+
+		delete object;
+		object = result;
+		std::cout << "Okay" << std::endl;
+	} else if(command == "assign_self"){
+		Hash_table<Type> &self = *object;
+
+		*object = self;
+		std::cout << "Okay" << std::endl;
+	} else if(command == "intersect" || command == "unite" || command == "subtract"){
+		//Replace the object by the result of the operation with the second operand
+
+		Hash_table<Type> *result = new Hash_table<Type>();
+
+		if(command == "intersect"){
+			object->intersect(*other, *result );
+		} else if(command == "unite"){
+			object->unite(*other, *result );
+		} else {
+			object->subtract(*other, *result );
+		}
+
+		delete object;
+		object = result;
+		std::cout << "Okay" << std::endl;
+	} else if(command == "intersect!"){
+		//The result cannot be one of the operands
+
+		try {
+			object->intersect(*other, *object );
+			std::cout << "Failed intersect(): expecting to catch an exception but did not" << std::endl;
+		} catch(illegal_argument){
+			std::cout << "Okay" << std::endl;
+		} catch (...) {
+			std::cout << "Failed intersect(): expecting an illegal_argument exception but caught a different exception" << std::endl;
+		}
+	} else if(command == "is_subset"){
+		//Check if every element of the object is in the second operand
+
+		bool expected_subset;
+
+		std::cin >> expected_subset;
+
+		bool actual_subset = object->is_subset(*other );
+
+		if(actual_subset == expected_subset){
+			std::cout << "Okay" << std::endl;
+		} else {
+			std::cout << ": Failed is_subset(): expecting the value '" << expected_subset << "' but got '" << actual_subset << "'" << std::endl;
+		}
 	} else if(command == "cout"){
 		std::cout << *object << std::endl;
 	} else {
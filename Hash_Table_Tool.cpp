@@ -0,0 +1,631 @@
+//Streams key files through a Hash_table: deduplication, distinct counting and
+//semi-/anti-joins of one file against another.
+//
+//  Hash_Table_Tool [--binary | --fingerprint] [--expected n] dedup    <file>
+//  Hash_Table_Tool [--binary | --fingerprint] [--expected n] distinct <file>
+//  Hash_Table_Tool [--binary | --fingerprint] --memory n [--spill prefix] distinct <file>
+//  Hash_Table_Tool [--binary | --fingerprint] [--expected n] semijoin <build file> <probe file>
+//  Hash_Table_Tool [--binary | --fingerprint] [--expected n] antijoin <build file> <probe file>
+//
+//Records are lines of text by default, or 8-byte binary records with --binary; a file
+//name of - reads standard input. Selected records are written to standard output and a
+//throughput report to standard error.
+//
+//Binary records are their own keys, scrambled by the bijective splitmix64 finalizer so that
+//keys sharing their low bits (aligned ids, scaled timestamps) do not share a home bin.
+//
+//Text records are hashed by a 64-bit fingerprint, and the table keeps a copy of the bytes
+//of every distinct build record so that a fingerprint match is confirmed by comparing the
+//records themselves. With --fingerprint only the fingerprints are kept: memory no longer
+//grows with the length of the lines, but two different lines are taken to be the same
+//record with probability about n^2/2^65 for n distinct lines.
+//
+//With --memory, distinct keeps at most n keys in memory and spills the rest to partition
+//files named prefix.<number> (by default in $TMPDIR or /tmp), so it can count more distinct
+//records than fit in memory. Only keys are spilled, so text input needs --fingerprint.
+
+#include <iostream>
+#include <new>
+#include <vector>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "Hash_Table.h"
+#include "Hash_Functions.h"
+#include "Spilling_Hash_Table.h"
+
+namespace {
+	const int BATCH = 64;						//Records whose home bins are prefetched together
+	const size_t READ_SIZE = 1 << 20;			//Bytes per read when a file cannot be mapped
+	const size_t ARENA_CHUNK = 1 << 20;			//Bytes per block of copied text records
+	const size_t BINARY_RECORD = 8;
+
+	enum tool_mode_t { DEDUP, DISTINCT, SEMIJOIN, ANTIJOIN };
+
+	//64-bit fingerprint of a record
+	long long fingerprint(char const *data, size_t length) {
+		return static_cast<long long>(hash_bytes(data, length));
+	}
+
+	//A batch of records: the key of each and where its bytes are
+	struct batch_t {
+		int size;
+		long long keys[BATCH];
+		char const *data[BATCH];
+		size_t length[BATCH];
+	};
+
+	//A text record compared by its bytes; Hash_table hashes it by its fingerprint
+	struct text_record_t {
+		long long key;
+		char const *data;
+		size_t length;
+
+		operator long long() const {
+			return key;
+		}
+
+		bool operator==(text_record_t const &other) const {
+			return key == other.key && length == other.length && std::memcmp(data, other.data, length) == 0;
+		}
+	};
+
+	//Owns the copies of the text records kept in a table. Records are copied before they
+	//are inserted, so a copy that turns out to be a duplicate is handed back with undo()
+	class Record_arena {
+		private:
+			std::vector<char *> chunks;
+			size_t used;
+			size_t chunk_size;
+
+		public:
+			Record_arena():used(0), chunk_size(0) {
+				//empty constructor
+			}
+
+			~Record_arena() {
+				for(size_t i = 0; i < chunks.size(); ++i) {
+					std::free(chunks[i]);
+				}
+			}
+
+			char const *copy(char const *data, size_t length) {
+				if(used + length > chunk_size || chunks.empty()) {
+					chunk_size = length > ARENA_CHUNK ? length : ARENA_CHUNK;
+					chunks.push_back(static_cast<char *>(std::malloc(chunk_size)));
+					used = 0;
+
+					if(chunks.back() == nullptr) {
+						throw overflow();
+					}
+				}
+
+				char *p = chunks.back() + used;
+
+				if(length > 0) {
+					std::memcpy(p, data, length);
+				}
+
+				used += length;
+
+				return p;
+			}
+
+			//Releases the most recent copy
+			void undo(size_t length) {
+				used -= length;
+			}
+	};
+
+	//The key a table stores for record i of a batch; text records are copied into the arena
+	template <typename Key>
+	Key keep(batch_t const &batch, int i, Record_arena &arena);
+
+	template <>
+	long long keep<long long>(batch_t const &batch, int i, Record_arena &) {
+		return batch.keys[i];
+	}
+
+	template <>
+	text_record_t keep<text_record_t>(batch_t const &batch, int i, Record_arena &arena) {
+		text_record_t record = { batch.keys[i], arena.copy(batch.data[i], batch.length[i]), batch.length[i] };
+
+		return record;
+	}
+
+	//Hands back what keep() took when the record was already in the table
+	template <typename Key>
+	void discard(batch_t const &batch, int i, Record_arena &arena);
+
+	template <>
+	void discard<long long>(batch_t const &, int, Record_arena &) {
+		//nothing was copied
+	}
+
+	template <>
+	void discard<text_record_t>(batch_t const &batch, int i, Record_arena &arena) {
+		arena.undo(batch.length[i]);
+	}
+
+	//The key used to look record i of a batch up; text records are not copied
+	template <typename Key>
+	Key probe_key(batch_t const &batch, int i);
+
+	template <>
+	long long probe_key<long long>(batch_t const &batch, int i) {
+		return batch.keys[i];
+	}
+
+	template <>
+	text_record_t probe_key<text_record_t>(batch_t const &batch, int i) {
+		text_record_t record = { batch.keys[i], batch.data[i], batch.length[i] };
+
+		return record;
+	}
+
+	struct statistics_t {
+		long long records;
+		long long bytes;
+		long long written;
+	};
+
+	//Reads every record of a file and hands it to the consumer in batches
+	class Record_reader {
+		private:
+			bool binary;
+
+		public:
+			Record_reader(bool b):binary(b) {
+				//empty constructor
+			}
+
+			template <typename Consumer>
+			bool read(char const *path, Consumer &consumer, statistics_t &stats) const;
+
+		private:
+			//Splits [begin, end) into records; returns the start of an incomplete last record
+			//(end if there is none). If final is true, an incomplete last record is passed on too
+			template <typename Consumer>
+			char const *split(char const *begin, char const *end, bool final, Consumer &consumer, statistics_t &stats) const;
+	};
+
+	template <typename Consumer>
+	char const *Record_reader::split(char const *begin, char const *end, bool final, Consumer &consumer, statistics_t &stats) const {
+		batch_t batch;
+		batch.size = 0;
+
+		char const *p = begin;
+
+		while(p < end) {
+			char const *record_end;
+			char const *next;
+
+			if(binary) {
+				if(static_cast<size_t>(end - p) < BINARY_RECORD) {
+					if(!final) {
+						break;
+					}
+					record_end = end;
+				} else {
+					record_end = p + BINARY_RECORD;
+				}
+				next = record_end;
+			} else {
+				record_end = static_cast<char const *>(std::memchr(p, '\n', end - p));
+				if(record_end == nullptr) {
+					if(!final) {
+						break;
+					}
+					record_end = end;
+					next = end;
+				} else {
+					next = record_end + 1;
+				}
+			}
+
+			size_t length = record_end - p;
+			long long key;
+
+			if(binary && length == BINARY_RECORD) {
+				unsigned long long bits;
+				std::memcpy(&bits, p, sizeof(bits));
+				key = static_cast<long long>(splitmix64(bits));
+			} else {
+				key = fingerprint(p, length);
+			}
+
+			batch.keys[batch.size] = key;
+			batch.data[batch.size] = p;
+			batch.length[batch.size] = length;
+			++batch.size;
+			++stats.records;
+
+			if(batch.size == BATCH) {
+				consumer(batch);
+				batch.size = 0;
+			}
+
+			p = next;
+		}
+
+		if(batch.size > 0) {
+			consumer(batch);
+		}
+
+		stats.bytes += p - begin;
+
+		return p;
+	}
+
+	//Maps the whole file if possible; otherwise (pipes, standard input) reads it in large chunks
+	template <typename Consumer>
+	bool Record_reader::read(char const *path, Consumer &consumer, statistics_t &stats) const {
+		int fd = std::strcmp(path, "-") ? open(path, O_RDONLY) : 0;
+
+		if(fd < 0) {
+			std::perror(path);
+			return false;
+		}
+
+		struct stat info;
+
+		if(fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+			void *map = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+			if(map != MAP_FAILED) {
+				madvise(map, info.st_size, MADV_SEQUENTIAL);
+				char const *data = static_cast<char const *>(map);
+				split(data, data + info.st_size, true, consumer, stats);
+				munmap(map, info.st_size);
+
+				if(fd != 0) {
+					close(fd);
+				}
+
+				return true;
+			}
+		}
+
+		//A record cut off at the end of one read is moved to the front of the buffer
+		size_t capacity = READ_SIZE;
+		char *buffer = static_cast<char *>(std::malloc(capacity));
+		size_t kept = 0;
+		bool ok = true;
+
+		while(true) {
+			if(kept == capacity) {
+				//A single record longer than the buffer
+				capacity *= 2;
+				buffer = static_cast<char *>(std::realloc(buffer, capacity));
+			}
+
+			ssize_t got = ::read(fd, buffer + kept, capacity - kept);
+
+			if(got < 0) {
+				std::perror(path);
+				ok = false;
+				break;
+			}
+
+			bool final = (got == 0);
+			char const *rest = split(buffer, buffer + kept + got, final, consumer, stats);
+			kept = buffer + kept + got - rest;
+			std::memmove(buffer, rest, kept);
+
+			if(final) {
+				break;
+			}
+		}
+
+		std::free(buffer);
+
+		if(fd != 0) {
+			close(fd);
+		}
+
+		return ok;
+	}
+
+	//Grows the table before it passes a load factor of 3/4
+	template <typename Key>
+	void make_room(Hash_table<Key> &table, int extra) {
+		if(4*(table.size() + extra) > 3*table.capacity()) {
+			table.reserve(2*(table.size() + extra));
+		}
+	}
+
+	void write_record(batch_t const &batch, int i, bool binary) {
+		std::fwrite(batch.data[i], 1, batch.length[i], stdout);
+
+		if(!binary) {
+			std::fputc('\n', stdout);
+		}
+	}
+
+	//Inserts every record; for dedup, writes each record the first time its key is seen
+	template <typename Key>
+	struct Build {
+		Hash_table<Key> &table;
+		Record_arena &arena;
+		bool output;
+		bool binary;
+		statistics_t &stats;
+
+		Build(Hash_table<Key> &t, Record_arena &a, bool o, bool b, statistics_t &s):table(t), arena(a), output(o), binary(b), stats(s) {
+			//empty constructor
+		}
+
+		void operator()(batch_t const &batch) {
+			make_room(table, batch.size);
+
+			for(int i = 0; i < batch.size; ++i) {
+				table.prefetch(probe_key<Key>(batch, i));
+			}
+
+			//insert() ignores keys already present, so a change in size marks a new key
+			for(int i = 0; i < batch.size; ++i) {
+				bin_index_t before = table.size();
+				table.insert(keep<Key>(batch, i, arena));
+
+				if(table.size() != before) {
+					if(output) {
+						write_record(batch, i, binary);
+						++stats.written;
+					}
+				} else {
+					discard<Key>(batch, i, arena);
+				}
+			}
+		}
+	};
+
+	//Writes every record whose key is (semijoin) or is not (antijoin) in the table
+	template <typename Key>
+	struct Probe {
+		Hash_table<Key> const &table;
+		bool keep_members;
+		bool binary;
+		statistics_t &stats;
+
+		Probe(Hash_table<Key> const &t, bool k, bool b, statistics_t &s):table(t), keep_members(k), binary(b), stats(s) {
+			//empty constructor
+		}
+
+		void operator()(batch_t const &batch) {
+			for(int i = 0; i < batch.size; ++i) {
+				table.prefetch(probe_key<Key>(batch, i));
+			}
+
+			for(int i = 0; i < batch.size; ++i) {
+				if(table.member(probe_key<Key>(batch, i)) == keep_members) {
+					write_record(batch, i, binary);
+					++stats.written;
+				}
+			}
+		}
+	};
+
+	//Inserts every record into a table that spills to disk past its memory budget
+	struct Spill_build {
+		Spilling_hash_table<long long> &table;
+
+		Spill_build(Spilling_hash_table<long long> &t):table(t) {
+			//empty constructor
+		}
+
+		void operator()(batch_t const &batch) {
+			for(int i = 0; i < batch.size; ++i) {
+				table.insert(batch.keys[i]);
+			}
+		}
+	};
+
+	void report(char const *phase, statistics_t const &stats, double seconds) {
+		std::cerr << phase << ": " << stats.records << " records, "
+		          << stats.bytes/1048576.0 << " MiB in " << seconds << " s ("
+		          << (seconds > 0 ? stats.records/seconds/1e6 : 0.0) << " M records/s, "
+		          << (seconds > 0 ? stats.bytes/seconds/1048576.0 : 0.0) << " MiB/s)" << std::endl;
+	}
+
+	double seconds_since(std::chrono::steady_clock::time_point start) {
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	int usage(char const *name) {
+		std::cerr << "Usage: " << name << " [--binary | --fingerprint] [--expected n] dedup|distinct <file>" << std::endl
+		          << "       " << name << " [--binary | --fingerprint] --memory n [--spill prefix] distinct <file>" << std::endl
+		          << "       " << name << " [--binary | --fingerprint] [--expected n] semijoin|antijoin <build file> <probe file>" << std::endl;
+
+		return -1;
+	}
+
+	//Reads the count given to option; the whole argument has to be a number of at least minimum
+	bool parse_count(char const *name, char const *option, char const *text, long long minimum, long long &n) {
+		char *end;
+
+		errno = 0;
+		n = std::strtoll(text, &end, 10);
+
+		if(end == text || *end != '\0' || errno != 0 || n < minimum) {
+			std::cerr << name << ": " << option << " expects a count of at least " << minimum << ", not '" << text << "'" << std::endl;
+
+			return false;
+		}
+
+		return true;
+	}
+
+	//Builds a table from the first file, then writes the distinct count or probes the second
+	template <typename Key>
+	int run(tool_mode_t mode, bool binary, long long expected, char const *build_path, char const *probe_path) {
+		Record_reader reader(binary);
+		Record_arena arena;
+		Hash_table<Key> table(10);
+		table.reserve(expected);
+
+		statistics_t build_stats = { 0, 0, 0 };
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		Build<Key> build(table, arena, mode == DEDUP, binary, build_stats);
+
+		if(!reader.read(build_path, build, build_stats)) {
+			return 1;
+		}
+
+		report(mode == DEDUP ? "dedup" : "build", build_stats, seconds_since(start));
+
+		if(mode == DEDUP || mode == DISTINCT) {
+			std::cerr << "distinct: " << table.size() << std::endl;
+
+			if(mode == DISTINCT) {
+				std::cout << table.size() << std::endl;
+			}
+		} else {
+			statistics_t probe_stats = { 0, 0, 0 };
+			start = std::chrono::steady_clock::now();
+			Probe<Key> probe(table, mode == SEMIJOIN, binary, probe_stats);
+
+			if(!reader.read(probe_path, probe, probe_stats)) {
+				return 1;
+			}
+
+			report("probe", probe_stats, seconds_since(start));
+			std::cerr << "written: " << probe_stats.written << std::endl;
+		}
+
+		std::fflush(stdout);
+
+		return 0;
+	}
+}
+
+int main(int argc, char *argv[]) {
+	bool binary = false;
+	bool fingerprints_only = false;
+	long long expected = 0;
+	long long memory = 0;
+	char const *spill = nullptr;
+	int arg = 1;
+
+	for(; arg < argc && argv[arg][0] == '-' && argv[arg][1] == '-'; ++arg) {
+		if(!std::strcmp(argv[arg], "--binary")) {
+			binary = true;
+		} else if(!std::strcmp(argv[arg], "--fingerprint")) {
+			fingerprints_only = true;
+		} else if(!std::strcmp(argv[arg], "--expected") && arg + 1 < argc) {
+			if(!parse_count(argv[0], argv[arg], argv[arg + 1], 0, expected)) {
+				return -1;
+			}
+
+			++arg;
+		} else if(!std::strcmp(argv[arg], "--memory") && arg + 1 < argc) {
+			if(!parse_count(argv[0], argv[arg], argv[arg + 1], 1, memory)) {
+				return -1;
+			}
+
+			++arg;
+		} else if(!std::strcmp(argv[arg], "--spill") && arg + 1 < argc) {
+			spill = argv[++arg];
+		} else {
+			return usage(argv[0]);
+		}
+	}
+
+	if(argc - arg < 2) {
+		return usage(argv[0]);
+	}
+
+	tool_mode_t mode;
+
+	if(!std::strcmp(argv[arg], "dedup")) {
+		mode = DEDUP;
+	} else if(!std::strcmp(argv[arg], "distinct")) {
+		mode = DISTINCT;
+	} else if(!std::strcmp(argv[arg], "semijoin")) {
+		mode = SEMIJOIN;
+	} else if(!std::strcmp(argv[arg], "antijoin")) {
+		mode = ANTIJOIN;
+	} else {
+		return usage(argv[0]);
+	}
+
+	if((mode == SEMIJOIN || mode == ANTIJOIN) != (argc - arg == 3)) {
+		return usage(argv[0]);
+	}
+
+	if((memory != 0 || spill != nullptr) && (mode != DISTINCT || memory < 1 || !(binary || fingerprints_only))) {
+		return usage(argv[0]);
+	}
+
+	if(binary && fingerprints_only) {
+		return usage(argv[0]);
+	}
+
+	static char output_buffer[1 << 20];
+	std::setvbuf(stdout, output_buffer, _IOFBF, sizeof(output_buffer));
+
+	Record_reader reader(binary);
+
+	if(memory > 0) {
+		char default_spill[4096];
+
+		if(spill == nullptr) {
+			char const *directory = std::getenv("TMPDIR");
+			std::snprintf(default_spill, sizeof(default_spill), "%s/Hash_Table_Tool.%ld",
+			              directory != nullptr ? directory : "/tmp", static_cast<long>(getpid()));
+			spill = default_spill;
+		}
+
+		try {
+			Spilling_hash_table<long long> spilling(spill, memory);
+			statistics_t stats = { 0, 0, 0 };
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			Spill_build build(spilling);
+
+			if(!reader.read(argv[arg + 1], build, stats)) {
+				return 1;
+			}
+
+			bin_index_t distinct = spilling.finish();
+
+			report("distinct", stats, seconds_since(start));
+			std::cerr << "distinct: " << distinct << ", spilled: " << spilling.bytes_spilled()/1048576.0 << " MiB" << std::endl;
+			std::cout << distinct << std::endl;
+		} catch(io_error) {
+			std::perror(spill);
+			return 1;
+		} catch(overflow) {
+			std::cerr << argv[0] << ": the records do not fit in memory" << std::endl;
+			return 1;
+		} catch(std::bad_alloc &) {
+			std::cerr << argv[0] << ": out of memory" << std::endl;
+			return 1;
+		}
+
+		std::fflush(stdout);
+
+		return 0;
+	}
+
+	char const *probe_path = (argc - arg == 3) ? argv[arg + 2] : nullptr;
+
+	//overflow comes from a table that cannot grow to hold the records (or the expected count)
+	try {
+		if(binary || fingerprints_only) {
+			return run<long long>(mode, binary, expected, argv[arg + 1], probe_path);
+		}
+
+		return run<text_record_t>(mode, binary, expected, argv[arg + 1], probe_path);
+	} catch(overflow) {
+		std::cerr << argv[0] << ": the records do not fit in memory" << std::endl;
+		return 1;
+	} catch(std::bad_alloc &) {
+		std::cerr << argv[0] << ": out of memory" << std::endl;
+		return 1;
+	}
+}
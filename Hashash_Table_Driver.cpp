@@ -1,6 +1,11 @@
 #include <iostream>
 #include <cstring>
 #include "Hash_Table_Tester.h"
+#include "Counting_Hash_Table_Tester.h"
+#include "Quotient_Set_Tester.h"
+#include "Frozen_Hash_Table_Tester.h"
+#include "Logged_Hash_Table_Tester.h"
+#include "Spilling_Hash_Table_Tester.h"
 
 int main(int argc, char *argv[]) {
 	if(argc > 2) {
@@ -13,7 +18,7 @@ int main(int argc, char *argv[]) {
 
 	if(argc == 1 || !std::strcmp(argv[1], "int")) {
 		if(argc == 1) {
-			std::cerr << "Expecting a command-line argument of either 'int' or 'double', but got none; using 'int' by default." << std::endl;
+			std::cerr << "Expecting a command-line argument of either 'int', 'double', 'counting', 'quotient', 'quotient_long', 'frozen', 'logged' or 'spilling', but got none; using 'int' by default." << std::endl;
 		}
 
 		Hash_table_tester<int> tester;
@@ -22,6 +27,30 @@ int main(int argc, char *argv[]) {
 	} else if(!std::strcmp(argv[1], "double")) {
 		Hash_table_tester<double> tester;
 
+		tester.run();
+	} else if(!std::strcmp(argv[1], "counting")) {
+		Counting_hash_table_tester<int> tester;
+
+		tester.run();
+	} else if(!std::strcmp(argv[1], "quotient")) {
+		Quotient_set_tester<int> tester;
+
+		tester.run();
+	} else if(!std::strcmp(argv[1], "quotient_long")) {
+		Quotient_set_tester<long long> tester;
+
+		tester.run();
+	} else if(!std::strcmp(argv[1], "frozen")) {
+		Frozen_hash_table_tester<int> tester;
+
+		tester.run();
+	} else if(!std::strcmp(argv[1], "logged")) {
+		Logged_hash_table_tester<long long> tester;
+
+		tester.run();
+	} else if(!std::strcmp(argv[1], "spilling")) {
+		Spilling_hash_table_tester<long long> tester;
+
 		tester.run();
 	}
 
@@ -0,0 +1,596 @@
+#ifndef LOGGED_HASH_TABLE_H
+#define LOGGED_HASH_TABLE_H
+
+#ifndef nullptr
+#define nullptr 0
+#endif
+
+#include "Exceptions.h"
+#include "Hash_Table.h"
+#include "File_IO.h"
+#include "Hash_Functions.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+//Hash_table whose contents survive a crash. Every insert and erase that changes the table is
+//appended to a write-ahead log, <path>.log, as one record (an operation byte followed by the
+//bytes of the key). Records are buffered and written with a single write() and fsync() once
+//group of them have accumulated, or when commit() is called (group commit). Each group is
+//preceded by its record count and a 64-bit checksum of the records, so recovery stops at the
+//first group that was not written whole. An operation is durable once the commit that follows
+//it has returned.
+//
+//When the log grows past compact_bytes, the whole table is written to a checkpoint,
+//<path>.checkpoint, and the log is emptied. On construction the checkpoint is loaded and the
+//log replayed on top of it, into a table presized for the result. Replaying a record twice
+//leaves the same table, so a crash between writing a checkpoint and emptying the log is safe.
+//
+//Keys are written as raw bytes, so Type has to be trivially copyable
+template <typename Type>
+class Logged_hash_table {
+	static_assert( std::is_trivially_copyable<Type>::value, "Logged_hash_table keys are written as raw bytes" );
+
+	private:
+		enum log_op_t : unsigned char { LOG_INSERT = 'I', LOG_ERASE = 'E' };
+
+		static const int RECORD = 1 + sizeof( Type );		//Bytes per log record
+		static const int GROUP_HEADER = 16;					//Record count and checksum before each group
+		static const int IO_SIZE = 1 << 20;					//Bytes per read() and write() of a checkpoint or log replay
+		static const int BATCH = 16;						//Keys whose home bins are prefetched together on recovery
+		static const unsigned int MAGIC = 0x4B434854;		//"HTCK", first word of a checkpoint
+
+		Hash_table<Type> table;
+		char *log_path;
+		char *checkpoint_path;
+		char *temporary_path;
+		char *directory_path;
+		int log_fd;
+		int group;					//Operations per group commit
+		long long compact_bytes;	//Log size at which a checkpoint is written
+		long long log_bytes;		//Bytes of committed groups in the log
+		unsigned char *pending;		//Header and records of the next group
+		int pending_count;
+
+		static char *concatenate( char const *, char const * );
+		static unsigned long long checksum( unsigned char const *, long long );
+
+		void make_room( bin_index_t );
+		void retry_full_group();
+		void append( log_op_t, Type const & );
+		void apply( unsigned char const *, int );
+		void write_pending( bool );
+		void sync_directory() const;
+		void load_checkpoint();
+		void replay_log();
+
+	public:
+		Logged_hash_table( char const *, int = 64, long long = 1LL << 26 );
+		~Logged_hash_table();
+
+		bin_index_t size() const;
+		bool empty() const;
+		bool member( Type const & ) const;
+		Hash_table<Type> const &contents() const;
+		long long log_size() const;
+
+		void insert( Type const & );
+		bool erase( Type const & );
+		void commit();
+		void checkpoint();
+
+	private:
+		Logged_hash_table( Logged_hash_table const & );
+		Logged_hash_table &operator=( Logged_hash_table const & );
+};
+
+//Constructor
+//path names the files without their suffix. Recovers whatever the files hold; a torn group
+//at the end of the log (from a crash in the middle of a write) is dropped.
+//Throws illegal_argument if group < 1 or the checkpoint is not one of this type, and
+//io_error if the files cannot be opened or read
+template <typename Type>
+Logged_hash_table<Type>::Logged_hash_table( char const *path, int g, long long c ):
+table( 5 ),
+log_path( concatenate( path, ".log" ) ),
+checkpoint_path( concatenate( path, ".checkpoint" ) ),
+temporary_path( concatenate( path, ".checkpoint.tmp" ) ),
+directory_path( concatenate( path, "" ) ),
+log_fd( -1 ),
+group( g ),
+compact_bytes( c ),
+log_bytes( 0 ),
+pending( nullptr ),
+pending_count( 0 ) {
+	//The log is created and the checkpoint renamed in this directory, so it has to be synced too
+	char *slash = std::strrchr( directory_path, '/' );
+
+	if ( slash == nullptr ) {
+		std::strcpy( directory_path, "." );
+	} else if ( slash == directory_path ) {
+		slash[1] = '\0';
+	} else {
+		*slash = '\0';
+	}
+
+	try {
+		if ( group < 1 ) {
+			throw illegal_argument();
+		}
+
+		pending = new unsigned char[GROUP_HEADER + group*RECORD];
+
+		load_checkpoint();
+		replay_log();
+
+		if ( log_bytes >= compact_bytes ) {
+			checkpoint();
+		}
+	} catch ( ... ) {
+		if ( log_fd >= 0 ) {
+			close( log_fd );
+		}
+
+		delete[] pending;
+		delete[] log_path;
+		delete[] checkpoint_path;
+		delete[] temporary_path;
+		delete[] directory_path;
+		throw;
+	}
+}
+
+//Destructor
+//Commits the pending operations; errors are ignored, as a destructor cannot report them
+template <typename Type>
+Logged_hash_table<Type>::~Logged_hash_table() {
+	try {
+		commit();
+	} catch ( ... ) {
+		//the pending operations are lost, as in a crash
+	}
+
+	close( log_fd );
+	delete[] pending;
+	delete[] log_path;
+	delete[] checkpoint_path;
+	delete[] temporary_path;
+	delete[] directory_path;
+}
+
+template <typename Type>
+char *Logged_hash_table<Type>::concatenate( char const *a, char const *b ) {
+	char *result = new char[std::strlen( a ) + std::strlen( b ) + 2];
+
+	std::strcpy( result, a );
+	std::strcat( result, b );
+
+	return result;
+}
+
+//Checksum of a group of n records; the count is mixed in so that a header is tied to its group
+template <typename Type>
+unsigned long long Logged_hash_table<Type>::checksum( unsigned char const *records, long long n ) {
+	return splitmix64( hash_bytes( records, n*RECORD ) ^ static_cast<unsigned long long>( n ) );
+}
+
+//Grows the table before extra more elements would take it past a load factor of 3/4
+template <typename Type>
+void Logged_hash_table<Type>::make_room( bin_index_t extra ) {
+	if ( 4*(table.size() + extra) > 3*table.capacity() ) {
+		table.reserve( 2*(table.size() + extra) );
+	}
+}
+
+//A commit that failed leaves a full group pending. It is retried before the table is changed
+//again, so that if it fails once more the operation throws io_error without being applied
+template <typename Type>
+void Logged_hash_table<Type>::retry_full_group() {
+	if ( pending_count == group ) {
+		commit();
+	}
+}
+
+//Buffers the record of an operation already applied to the table, and commits once group
+//records are pending. If that commit throws, the operation stays applied and pending
+template <typename Type>
+void Logged_hash_table<Type>::append( log_op_t op, Type const &obj ) {
+	unsigned char *record = pending + GROUP_HEADER + pending_count*RECORD;
+
+	record[0] = op;
+	std::memcpy( record + 1, &obj, sizeof( Type ) );
+	++pending_count;
+
+	if ( pending_count == group ) {
+		commit();
+	}
+}
+
+//Applies n log records, prefetching the home bins of each batch before touching any of them
+template <typename Type>
+void Logged_hash_table<Type>::apply( unsigned char const *records, int n ) {
+	Type keys[BATCH];
+
+	for ( int first = 0; first < n; first += BATCH ) {
+		int size = (n - first < BATCH) ? n - first : BATCH;
+
+		for ( int i = 0; i < size; ++i ) {
+			std::memcpy( &keys[i], records + (first + i)*RECORD + 1, sizeof( Type ) );
+			table.prefetch( keys[i] );
+		}
+
+		for ( int i = 0; i < size; ++i ) {
+			if ( records[(first + i)*RECORD] == LOG_INSERT ) {
+				table.insert( keys[i] );
+			} else {
+				table.erase( keys[i] );
+			}
+		}
+	}
+}
+
+//A checkpoint is MAGIC, sizeof( Type ) and the element count, followed by the elements
+template <typename Type>
+void Logged_hash_table<Type>::load_checkpoint() {
+	int fd = open( checkpoint_path, O_RDONLY );
+
+	if ( fd < 0 ) {
+		if ( errno == ENOENT ) {
+			return;
+		}
+
+		throw io_error();
+	}
+
+	unsigned char *buffer = new unsigned char[IO_SIZE];
+
+	try {
+		unsigned int header[2];
+		long long n;
+
+		if ( read_fully( fd, header, sizeof( header ) ) != sizeof( header )
+		  || read_fully( fd, &n, sizeof( n ) ) != sizeof( n )
+		  || header[0] != MAGIC || header[1] != sizeof( Type ) || n < 0 ) {
+			throw illegal_argument();
+		}
+
+		table.reserve( n );
+
+		const long long per_read = IO_SIZE/sizeof( Type );
+		Type keys[BATCH];
+
+		for ( long long done = 0; done < n; ) {
+			long long size = (n - done < per_read) ? n - done : per_read;
+
+			if ( read_fully( fd, buffer, size*sizeof( Type ) ) != static_cast<long long>( size*sizeof( Type ) ) ) {
+				throw illegal_argument();
+			}
+
+			for ( long long first = 0; first < size; first += BATCH ) {
+				int batch = (size - first < BATCH) ? size - first : BATCH;
+
+				for ( int i = 0; i < batch; ++i ) {
+					std::memcpy( &keys[i], buffer + (first + i)*sizeof( Type ), sizeof( Type ) );
+					table.prefetch( keys[i] );
+				}
+
+				for ( int i = 0; i < batch; ++i ) {
+					table.insert( keys[i] );
+				}
+			}
+
+			done += size;
+		}
+	} catch ( ... ) {
+		delete[] buffer;
+		close( fd );
+		throw;
+	}
+
+	delete[] buffer;
+	close( fd );
+}
+
+//Opens the log and replays it in two sequential passes: the first finds the end of the last
+//whole group whose checksum matches and counts the inserts, so the table can be presized; the
+//second applies the groups. Anything after the last valid group is cut off
+template <typename Type>
+void Logged_hash_table<Type>::replay_log() {
+	log_fd = open( log_path, O_RDWR | O_CREAT, 0644 );
+
+	if ( log_fd < 0 ) {
+		throw io_error();
+	}
+
+	//The log may have just been created, and a file is only durable once its directory entry is
+	sync_directory();
+
+	struct stat info;
+
+	if ( fstat( log_fd, &info ) != 0 ) {
+		throw io_error();
+	}
+
+	long long capacity = IO_SIZE;
+	unsigned char *buffer = new unsigned char[capacity];
+
+	try {
+		long long inserts = 0;
+		unsigned char header[GROUP_HEADER];
+
+		//Pass 1: validate the groups
+		while ( true ) {
+			long long n;
+			unsigned long long sum;
+
+			if ( read_fully( log_fd, header, GROUP_HEADER ) != GROUP_HEADER ) {
+				break;
+			}
+
+			std::memcpy( &n, header, sizeof( n ) );
+			std::memcpy( &sum, header + sizeof( n ), sizeof( sum ) );
+
+			if ( n < 1 || n > 0x7FFFFFFF || n > (info.st_size - log_bytes - GROUP_HEADER)/RECORD ) {
+				break;
+			}
+
+			if ( n*RECORD > capacity ) {
+				delete[] buffer;
+				buffer = nullptr;
+				capacity = n*RECORD;
+				buffer = new unsigned char[capacity];
+			}
+
+			if ( read_fully( log_fd, buffer, n*RECORD ) != n*RECORD || checksum( buffer, n ) != sum ) {
+				break;
+			}
+
+			long long group_inserts = 0;
+			bool valid = true;
+
+			for ( long long i = 0; i < n; ++i ) {
+				unsigned char op = buffer[i*RECORD];
+
+				valid = valid && (op == LOG_INSERT || op == LOG_ERASE);
+				group_inserts += (op == LOG_INSERT) ? 1 : 0;
+			}
+
+			if ( !valid ) {
+				break;
+			}
+
+			inserts += group_inserts;
+			log_bytes += GROUP_HEADER + n*RECORD;
+		}
+
+		if ( info.st_size != log_bytes ) {
+			if ( ftruncate( log_fd, log_bytes ) != 0 || fsync( log_fd ) != 0 ) {
+				throw io_error();
+			}
+		}
+
+		make_room( inserts );
+
+		if ( lseek( log_fd, 0, SEEK_SET ) != 0 ) {
+			throw io_error();
+		}
+
+		//Pass 2: apply them
+		for ( long long done = 0; done < log_bytes; ) {
+			long long n;
+
+			if ( read_fully( log_fd, header, GROUP_HEADER ) != GROUP_HEADER ) {
+				throw io_error();
+			}
+
+			std::memcpy( &n, header, sizeof( n ) );
+
+			if ( read_fully( log_fd, buffer, n*RECORD ) != n*RECORD ) {
+				throw io_error();
+			}
+
+			apply( buffer, static_cast<int>( n ) );
+			done += GROUP_HEADER + n*RECORD;
+		}
+	} catch ( ... ) {
+		delete[] buffer;
+		throw;
+	}
+
+	delete[] buffer;
+}
+
+//Accessors
+template <typename Type>
+bin_index_t Logged_hash_table<Type>::size() const {
+	return table.size();
+}
+
+template <typename Type>
+bool Logged_hash_table<Type>::empty() const {
+	return table.empty();
+}
+
+template <typename Type>
+bool Logged_hash_table<Type>::member( Type const &obj ) const {
+	return table.member( obj );
+}
+
+template <typename Type>
+Hash_table<Type> const &Logged_hash_table<Type>::contents() const {
+	return table;
+}
+
+//Returns the bytes of committed groups in the log
+template <typename Type>
+long long Logged_hash_table<Type>::log_size() const {
+	return log_bytes;
+}
+
+//Mutators
+//Operations that leave the table unchanged are not logged
+template <typename Type>
+void Logged_hash_table<Type>::insert( Type const &obj ) {
+	if ( table.member( obj ) ) {
+		return;
+	}
+
+	retry_full_group();
+	make_room( 1 );
+	table.insert( obj );
+	append( LOG_INSERT, obj );
+}
+
+template <typename Type>
+bool Logged_hash_table<Type>::erase( Type const &obj ) {
+	if ( !table.member( obj ) ) {
+		return false;
+	}
+
+	retry_full_group();
+	table.erase( obj );
+	append( LOG_ERASE, obj );
+
+	return true;
+}
+
+//Writes the pending records with one write() and makes them durable with one fsync().
+//Writes a checkpoint if the log has grown past compact_bytes. Throws io_error on failure
+template <typename Type>
+void Logged_hash_table<Type>::commit() {
+	if ( pending_count == 0 ) {
+		return;
+	}
+
+	write_pending( true );
+
+	if ( log_bytes >= compact_bytes ) {
+		checkpoint();
+	}
+}
+
+//Writes the pending records after the last committed group, as one group, synced if sync is
+//true. If the write or the sync fails, the log is cut back to its last committed group and the
+//records stay pending, so the next commit writes them again at a group boundary.
+//Throws io_error on failure
+template <typename Type>
+void Logged_hash_table<Type>::write_pending( bool sync ) {
+	long long n = pending_count;
+	unsigned long long sum = checksum( pending + GROUP_HEADER, n );
+
+	std::memcpy( pending, &n, sizeof( n ) );
+	std::memcpy( pending + sizeof( n ), &sum, sizeof( sum ) );
+
+	long long bytes = GROUP_HEADER + n*RECORD;
+
+	try {
+		if ( lseek( log_fd, log_bytes, SEEK_SET ) != log_bytes ) {
+			throw io_error();
+		}
+
+		write_fully( log_fd, pending, bytes );
+
+		if ( sync && fsync( log_fd ) != 0 ) {
+			throw io_error();
+		}
+	} catch ( ... ) {
+		//Groups are written at log_bytes, so even if this fails the next group overwrites the
+		//torn one, and recovery stops at the checksum of whatever is left after it
+		if ( ftruncate( log_fd, log_bytes ) != 0 ) {
+			//nothing more can be done here
+		}
+
+		throw;
+	}
+
+	pending_count = 0;
+	log_bytes += bytes;
+}
+
+//Syncs the directory holding the files, which makes their creation and renaming durable
+template <typename Type>
+void Logged_hash_table<Type>::sync_directory() const {
+	int directory = open( directory_path, O_RDONLY );
+
+	if ( directory < 0 ) {
+		throw io_error();
+	}
+
+	bool synced = (fsync( directory ) == 0);
+
+	close( directory );
+
+	if ( !synced ) {
+		throw io_error();
+	}
+}
+
+//Writes every element to a temporary file, syncs it and renames it over the checkpoint, then
+//empties the log. A crash at any point leaves either the old checkpoint and the full log or
+//the new checkpoint and a log that is already contained in it
+template <typename Type>
+void Logged_hash_table<Type>::checkpoint() {
+	if ( pending_count > 0 ) {
+		write_pending( false );
+	}
+
+	int fd = open( temporary_path, O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+
+	if ( fd < 0 ) {
+		throw io_error();
+	}
+
+	const long long per_write = IO_SIZE/sizeof( Type );
+	unsigned char *buffer = new unsigned char[IO_SIZE];
+
+	try {
+		unsigned int header[2] = { MAGIC, sizeof( Type ) };
+		long long n = table.size();
+		long long buffered = 0;
+
+		write_fully( fd, header, sizeof( header ) );
+		write_fully( fd, &n, sizeof( n ) );
+
+		for ( bin_index_t i = 0; i < table.array_size; ++i ) {
+			if ( table.occupied[i] == OCCUPIED ) {
+				std::memcpy( buffer + buffered*sizeof( Type ), table.array + i, sizeof( Type ) );
+
+				if ( ++buffered == per_write ) {
+					write_fully( fd, buffer, buffered*sizeof( Type ) );
+					buffered = 0;
+				}
+			}
+		}
+
+		write_fully( fd, buffer, buffered*sizeof( Type ) );
+
+		if ( fsync( fd ) != 0 ) {
+			throw io_error();
+		}
+	} catch ( ... ) {
+		delete[] buffer;
+		close( fd );
+		throw;
+	}
+
+	delete[] buffer;
+
+	if ( close( fd ) != 0 || std::rename( temporary_path, checkpoint_path ) != 0 ) {
+		throw io_error();
+	}
+
+	sync_directory();
+
+	if ( ftruncate( log_fd, 0 ) != 0 || fsync( log_fd ) != 0 ) {
+		throw io_error();
+	}
+
+	log_bytes = 0;
+}
+
+#endif
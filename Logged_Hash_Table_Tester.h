@@ -0,0 +1,299 @@
+#ifndef LOGGED_HASH_TABLE_TESTER_H
+#define LOGGED_HASH_TABLE_TESTER_H
+
+#ifndef nullptr
+#define nullptr 0
+#endif
+
+#include "Exceptions.h"
+#include "Test.h"
+#include "Logged_Hash_Table.h"
+
+#include <iostream>
+#include <string>
+#include <csignal>
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+//The commands that damage the log (truncate_log:, corrupt_log:, append_log:) work on the
+//files of a closed table, as a crash would leave them: delete the object first
+template <typename Type>
+class Logged_hash_table_tester:public test< Logged_hash_table<Type> > {
+	using test< Logged_hash_table<Type> >::object;
+	using test< Logged_hash_table<Type> >::command;
+
+	public:
+		Logged_hash_table_tester(Logged_hash_table<Type> *obj =
+0 ):test< Logged_hash_table<Type> >(obj){
+			//empty
+		}
+
+		void process();
+};
+
+template <typename Type>
+void Logged_hash_table_tester<Type>::process() {
+	if(command == "new:"){
+		//Recover the table from the files named by path, committing every group operations
+		//and checkpointing once the log reaches compact_bytes
+
+		std::string path;
+		int group;
+		long long compact_bytes;
+
+		std::cin >> path;
+		std::cin >> group;
+		std::cin >> compact_bytes;
+
+		object = new Logged_hash_table<Type>(path.c_str(), group, compact_bytes );
+		std::cout << "Okay" << std::endl;
+	} else if(command == "new!:"){
+		//The group size is out of range
+
+		std::string path;
+		int group;
+
+		std::cin >> path;
+		std::cin >> group;
+
+		try {
+			object = new Logged_hash_table<Type>(path.c_str(), group );
+			std::cout << "Failed Logged_hash_table(" << path << ", " << group << "): expecting to catch an exception but did not" << std::endl;
+		} catch(illegal_argument){
+			std::cout << "Okay" << std::endl;
+		} catch (...) {
+			std::cout << "Failed Logged_hash_table(" << path << ", " << group << "): expecting an illegal_argument exception but caught a different exception" << std::endl;
+		}
+	} else if(command == "remove:"){
+		//Delete the log and checkpoint files of path, if there are any
+
+		std::string path;
+
+		std::cin >> path;
+
+		std::remove((path + ".log").c_str() );
+		std::remove((path + ".checkpoint").c_str() );
+		std::remove((path + ".checkpoint.tmp").c_str() );
+		std::cout << "Okay" << std::endl;
+	} else if(command == "truncate_log:" || command == "corrupt_log:" || command == "append_log:"){
+		//Cut the last n bytes of the log (a torn write), flip the bits of the byte n bytes
+		//before its end (a corrupted sector), or add n bytes to it (a torn group header)
+
+		std::string path;
+		long long n;
+
+		std::cin >> path;
+		std::cin >> n;
+
+		int fd = open((path + ".log").c_str(), O_RDWR );
+		struct stat info;
+		bool done = false;
+
+		if(fd >= 0 && fstat(fd, &info ) == 0 && n <= info.st_size){
+			if(command == "truncate_log:"){
+				done = (ftruncate(fd, info.st_size - n ) == 0);
+			} else if(command == "corrupt_log:"){
+				unsigned char byte;
+
+				done = (n >= 1 && pread(fd, &byte, 1, info.st_size - n ) == 1);
+				byte = static_cast<unsigned char>(~byte );
+				done = done && (pwrite(fd, &byte, 1, info.st_size - n ) == 1);
+			} else {
+				unsigned char byte = 0x5A;
+
+				done = true;
+
+				for(long long i = 0; i < n && done; ++i){
+					done = (pwrite(fd, &byte, 1, info.st_size + i ) == 1);
+				}
+			}
+		}
+
+		if(fd >= 0){
+			close(fd );
+		}
+
+		if(done){
+			std::cout << "Okay" << std::endl;
+		} else {
+			std::cout << ": Failed " << command << " " << path << ".log: cannot change " << n << " bytes" << std::endl;
+		}
+	} else if(command == "file_size_limit:"){
+		//Limit the size of the files this process writes to n bytes, or lift the limit if n is
+		//negative; writes past the limit then fail with EFBIG instead of raising SIGXFSZ
+
+		long long n;
+
+		std::cin >> n;
+
+		struct rlimit limit;
+		bool done = (getrlimit(RLIMIT_FSIZE, &limit ) == 0);
+
+		if(done){
+			std::signal(SIGXFSZ, SIG_IGN );
+			limit.rlim_cur = (n < 0) ? limit.rlim_max : static_cast<rlim_t>(n );
+			done = (setrlimit(RLIMIT_FSIZE, &limit ) == 0);
+		}
+
+		if(done){
+			std::cout << "Okay" << std::endl;
+		} else {
+			std::cout << ": Failed " << command << " " << n << ": cannot set the limit" << std::endl;
+		}
+	} else if(command == "size"){
+		//Check if the size equals the next integer read
+
+		bin_index_t expected_size;
+
+		std::cin >> expected_size;
+
+		bin_index_t actual_size = object->size();
+
+		if(actual_size == expected_size){
+			std::cout << "Okay" << std::endl;
+		} else {
+			std::cout << ": Failed size(): expecting the value '" << expected_size << "' but got '" << actual_size << "'" << std::endl;
+		}
+	} else if(command == "log_size"){
+		//Check if the bytes of committed groups equal the next integer read
+
+		long long expected_bytes;
+
+		std::cin >> expected_bytes;
+
+		long long actual_bytes = object->log_size();
+
+		if(actual_bytes == expected_bytes){
+			std::cout << "Okay" << std::endl;
+		} else {
+			std::cout << ": Failed log_size(): expecting the value '" << expected_bytes << "' but got '" << actual_bytes << "'" << std::endl;
+		}
+	} else if(command == "member"){
+		//Check if the element is in the object
+
+		Type n;
+		bool expected_member;
+
+		std::cin >> n;
+		std::cin >> expected_member;
+
+		bool actual_member = object->member(n );
+
+		if(actual_member == expected_member){
+			std::cout << "Okay" << std::endl;
+		} else {
+			std::cout << ": Failed member(" << n << "): expecting the value '" << expected_member << "' but got '" << actual_member << "'" << std::endl;
+		}
+	} else if(command == "member_range"){
+		//Check member for a, a + 1, ..., b - 1 against the Boolean read
+
+		Type a;
+		Type b;
+		bool expected_member;
+
+		std::cin >> a;
+		std::cin >> b;
+		std::cin >> expected_member;
+
+		Type n = a;
+
+		while(n < b && object->member(n ) == expected_member){
+			++n;
+		}
+
+		if(n == b){
+			std::cout << "Okay" << std::endl;
+		} else {
+			std::cout << ": Failed member(" << n << "): expecting the value '" << expected_member << "' but got '" << !expected_member << "'" << std::endl;
+		}
+	} else if(command == "insert"){
+		Type n;
+
+		std::cin >> n;
+
+		object->insert(n );
+		std::cout << "Okay" << std::endl;
+	} else if(command == "insert_range"){
+		//Insert a, a + 1, ..., b - 1
+
+		Type a;
+		Type b;
+
+		std::cin >> a;
+		std::cin >> b;
+
+		for(Type n = a; n < b; ++n){
+			object->insert(n );
+		}
+
+		std::cout << "Okay" << std::endl;
+	} else if(command == "insert!"){
+		//The commit that the insert triggers or retries fails
+
+		Type n;
+
+		std::cin >> n;
+
+		try {
+			object->insert(n );
+			std::cout << "Failed insert(" << n << "): expecting to catch an exception but did not" << std::endl;
+		} catch(io_error){
+			std::cout << "Okay" << std::endl;
+		} catch (...) {
+			std::cout << "Failed insert(" << n << "): expecting an io_error exception but caught a different exception" << std::endl;
+		}
+	} else if(command == "erase!"){
+		//The commit that the erase retries fails
+
+		Type n;
+
+		std::cin >> n;
+
+		try {
+			object->erase(n );
+			std::cout << "Failed erase(" << n << "): expecting to catch an exception but did not" << std::endl;
+		} catch(io_error){
+			std::cout << "Okay" << std::endl;
+		} catch (...) {
+			std::cout << "Failed erase(" << n << "): expecting an io_error exception but caught a different exception" << std::endl;
+		}
+	} else if(command == "commit!"){
+		try {
+			object->commit();
+			std::cout << "Failed commit(): expecting to catch an exception but did not" << std::endl;
+		} catch(io_error){
+			std::cout << "Okay" << std::endl;
+		} catch (...) {
+			std::cout << "Failed commit(): expecting an io_error exception but caught a different exception" << std::endl;
+		}
+	} else if(command == "erase"){
+		Type n;
+		bool expected_value;
+
+		std::cin >> n;
+		std::cin >> expected_value;
+
+		bool actual_value = object->erase(n );
+
+		if(actual_value == expected_value){
+			std::cout << "Okay" << std::endl;
+		} else {
+			std::cout << ": Failed erase(" << n << "): expecting the value '" << expected_value << "' but got '" << actual_value << "'" << std::endl;
+		}
+	} else if(command == "commit"){
+		object->commit();
+
+		std::cout << "Okay" << std::endl;
+	} else if(command == "checkpoint"){
+		object->checkpoint();
+
+		std::cout << "Okay" << std::endl;
+	} else {
+		std::cout << command << ": Command not found." << std::endl;
+	}
+}
+#endif
@@ -0,0 +1,421 @@
+#ifndef QUOTIENT_SET_H
+#define QUOTIENT_SET_H
+
+#ifndef nullptr
+#define nullptr 0
+#endif
+
+#include "Exceptions.h"
+
+#include <iostream>
+#include <type_traits>
+
+//Compact set of integers (quotient filter layout).
+//A key of W bits is first scrambled by a bijection of the W-bit integers; the low 'power'
+//bits of the result (the quotient) pick the home slot and only the remaining W - power bits
+//(the remainder) are stored, packed into a bit array, together with three metadata bits per slot.
+//Because the scrambling is invertible, quotient and remainder together identify the key
+//exactly, so membership answers are exact, at W - power + 3 bits per slot.
+//
+//Slot metadata, as in Bender et al., "Don't Thrash: How to Cache Your Hash on Flash":
+//  occupied:     some key has this slot as its home slot
+//  continuation: this slot continues the run of remainders started in an earlier slot
+//  shifted:      the remainder in this slot is not in its home slot
+//The remainders of keys with the same quotient form a sorted run; runs are stored in
+//quotient order, each starting at its home slot or right after the previous run.
+template <typename Type>
+class Quotient_set {
+	static_assert( std::is_integral<Type>::value, "Quotient_set needs an integer key type" );
+
+	private:
+		static const int KEY_BITS = 8*sizeof( Type );
+
+		long long count;
+		int power;
+		int remainder_bits;
+		long long array_size;
+		long long mask;
+		unsigned long long *remainders;		//array_size remainders of remainder_bits bits each
+		unsigned long long *metadata;		//Three bit vectors of array_size bits
+		unsigned long long *run_quotient;	//Scratch space for rebuilding a cluster
+		unsigned long long *run_remainder;
+		long long scratch_size;
+
+		unsigned long long scramble( Type ) const;
+
+		bool get_bit( int, long long ) const;
+		void set_bit( int, long long, bool );
+		unsigned long long get_remainder( long long ) const;
+		void set_remainder( long long, unsigned long long );
+		bool is_empty( long long ) const;
+		long long find_run_start( long long ) const;
+		long long decode( long long );
+		void encode( long long, long long );
+
+	public:
+		Quotient_set( int = 5 );
+		~Quotient_set();
+		long long size() const;
+		long long capacity() const;
+		double load_factor() const;
+		bool empty() const;
+		bool member( Type const & ) const;
+		long long memory_bits() const;
+
+		void insert( Type const & );
+		bool erase( Type const & );
+		void clear();
+
+	private:
+		Quotient_set( Quotient_set const & );
+		Quotient_set &operator=( Quotient_set const & );
+};
+
+enum quotient_bit_t { SLOT_OCCUPIED, SLOT_CONTINUATION, SLOT_SHIFTED };
+
+//Constructor
+//Throws illegal_argument unless 1 <= power < the number of bits in Type
+template <typename Type>
+Quotient_set<Type>::Quotient_set( int m ):
+count( 0 ), power( m ),
+remainder_bits( KEY_BITS - m ),
+array_size( 0 ),
+mask( 0 ),
+remainders( nullptr ),
+metadata( nullptr ),
+run_quotient( new unsigned long long[64] ),
+run_remainder( new unsigned long long[64] ),
+scratch_size( 64 ) {
+	if ( m < 1 || m >= KEY_BITS || m > 62 ) {
+		delete[] run_remainder;
+		delete[] run_quotient;
+		throw illegal_argument();
+	}
+
+	array_size = 1LL << power;
+	mask = array_size - 1;
+
+	//One spare word so that a remainder straddling the last word can be read as two words
+	remainders = new unsigned long long[(array_size*remainder_bits + 63)/64 + 1];
+	metadata = new unsigned long long[3*((array_size + 63)/64)];
+	clear();
+}
+
+//Destructor
+template <typename Type>
+Quotient_set<Type>::~Quotient_set() {
+	delete[] run_remainder;
+	delete[] run_quotient;
+	delete[] metadata;
+	delete[] remainders;
+}
+
+//Bijection of the KEY_BITS-bit integers: multiplying by an odd constant and xor-ing
+//in the high half are both invertible modulo 2^KEY_BITS
+template <typename Type>
+unsigned long long Quotient_set<Type>::scramble( Type obj ) const {
+	const unsigned long long key_mask = (KEY_BITS == 64) ? ~0ULL : (1ULL << (KEY_BITS % 64)) - 1;
+	unsigned long long x = static_cast<unsigned long long>( obj ) & key_mask;
+
+	x = (x*0x9E3779B97F4A7C15ULL) & key_mask;
+	x ^= x >> (KEY_BITS/2);
+	x = (x*0xC2B2AE3D27D4EB4FULL) & key_mask;
+
+	return x;
+}
+
+//Bit and remainder access
+template <typename Type>
+bool Quotient_set<Type>::get_bit( int which, long long slot ) const {
+	unsigned long long const *bits = metadata + which*((array_size + 63)/64);
+
+	return (bits[slot >> 6] >> (slot & 63)) & 1;
+}
+
+template <typename Type>
+void Quotient_set<Type>::set_bit( int which, long long slot, bool value ) {
+	unsigned long long *bits = metadata + which*((array_size + 63)/64);
+
+	if ( value ) {
+		bits[slot >> 6] |= 1ULL << (slot & 63);
+	} else {
+		bits[slot >> 6] &= ~(1ULL << (slot & 63));
+	}
+}
+
+template <typename Type>
+unsigned long long Quotient_set<Type>::get_remainder( long long slot ) const {
+	long long offset = slot*remainder_bits;
+	int shift = static_cast<int>( offset & 63 );
+	unsigned long long value = remainders[offset >> 6] >> shift;
+
+	if ( shift + remainder_bits > 64 ) {
+		value |= remainders[(offset >> 6) + 1] << (64 - shift);
+	}
+
+	return value & ((1ULL << remainder_bits) - 1);
+}
+
+template <typename Type>
+void Quotient_set<Type>::set_remainder( long long slot, unsigned long long value ) {
+	long long offset = slot*remainder_bits;
+	int shift = static_cast<int>( offset & 63 );
+	unsigned long long field = (1ULL << remainder_bits) - 1;
+
+	remainders[offset >> 6] = (remainders[offset >> 6] & ~(field << shift)) | (value << shift);
+
+	if ( shift + remainder_bits > 64 ) {
+		remainders[(offset >> 6) + 1] = (remainders[(offset >> 6) + 1] & ~(field >> (64 - shift)))
+		                              | (value >> (64 - shift));
+	}
+}
+
+template <typename Type>
+bool Quotient_set<Type>::is_empty( long long slot ) const {
+	return !get_bit( SLOT_OCCUPIED, slot ) && !get_bit( SLOT_CONTINUATION, slot ) && !get_bit( SLOT_SHIFTED, slot );
+}
+
+//Returns the slot where the run of quotient q starts; q must be occupied.
+//Walk back to the start of the cluster, then forward one run per occupied quotient until q
+template <typename Type>
+long long Quotient_set<Type>::find_run_start( long long q ) const {
+	long long b = q;
+
+	while ( get_bit( SLOT_SHIFTED, b ) ) {
+		b = (b - 1) & mask;
+	}
+
+	long long s = b;
+
+	while ( b != q ) {
+		do {
+			s = (s + 1) & mask;
+		} while ( get_bit( SLOT_CONTINUATION, s ) );
+
+		do {
+			b = (b + 1) & mask;
+		} while ( !get_bit( SLOT_OCCUPIED, b ) );
+	}
+
+	return s;
+}
+
+//Reads every entry from the cluster start c up to the next empty slot into the scratch
+//arrays, as quotient offsets from c and remainders in stored order, and clears those slots.
+//Returns the number of entries
+template <typename Type>
+long long Quotient_set<Type>::decode( long long c ) {
+	long long n = 0;
+	long long quotient = c;
+
+	for ( long long s = c; !is_empty( s ); s = (s + 1) & mask ) {
+		if ( !get_bit( SLOT_CONTINUATION, s ) ) {
+			//A new run: it belongs to this slot if unshifted, otherwise to the next occupied quotient
+			if ( !get_bit( SLOT_SHIFTED, s ) ) {
+				quotient = s;
+			} else {
+				do {
+					quotient = (quotient + 1) & mask;
+				} while ( !get_bit( SLOT_OCCUPIED, quotient ) );
+			}
+		}
+
+		if ( n + 1 >= scratch_size ) {
+			long long new_size = 2*scratch_size;
+			unsigned long long *new_quotient = new unsigned long long[new_size];
+			unsigned long long *new_remainder = new unsigned long long[new_size];
+
+			for ( long long i = 0; i < n; ++i ) {
+				new_quotient[i] = run_quotient[i];
+				new_remainder[i] = run_remainder[i];
+			}
+
+			delete[] run_quotient;
+			delete[] run_remainder;
+			run_quotient = new_quotient;
+			run_remainder = new_remainder;
+			scratch_size = new_size;
+		}
+
+		run_quotient[n] = (quotient - c) & mask;
+		run_remainder[n] = get_remainder( s );
+		++n;
+	}
+
+	for ( long long i = 0; i < n; ++i ) {
+		long long s = (c + i) & mask;
+
+		set_bit( SLOT_OCCUPIED, s, false );
+		set_bit( SLOT_CONTINUATION, s, false );
+		set_bit( SLOT_SHIFTED, s, false );
+	}
+
+	return n;
+}
+
+//Writes n scratch entries (sorted by quotient offset, then remainder) back starting at
+//cluster start c: each run goes to its home slot or right after the previous run
+template <typename Type>
+void Quotient_set<Type>::encode( long long c, long long n ) {
+	long long position = 0;
+
+	for ( long long i = 0; i < n; ++i ) {
+		long long home = static_cast<long long>( run_quotient[i] );
+		bool continuation = (i > 0 && run_quotient[i - 1] == run_quotient[i]);
+
+		if ( !continuation && position < home ) {
+			position = home;
+		}
+
+		long long s = (c + position) & mask;
+
+		set_bit( SLOT_OCCUPIED, (c + home) & mask, true );
+		set_bit( SLOT_CONTINUATION, s, continuation );
+		set_bit( SLOT_SHIFTED, s, position != home );
+		set_remainder( s, run_remainder[i] );
+		++position;
+	}
+}
+
+//Accessors
+template <typename Type>
+long long Quotient_set<Type>::size() const {
+	return count;
+}
+
+template <typename Type>
+long long Quotient_set<Type>::capacity() const {
+	return array_size;
+}
+
+template <typename Type>
+double Quotient_set<Type>::load_factor() const {
+	return static_cast<double>( count )/array_size;
+}
+
+template <typename Type>
+bool Quotient_set<Type>::empty() const {
+	return (count == 0);
+}
+
+//Returns the number of bits used by the slots (remainders and metadata)
+template <typename Type>
+long long Quotient_set<Type>::memory_bits() const {
+	return array_size*(remainder_bits + 3);
+}
+
+template <typename Type>
+bool Quotient_set<Type>::member( Type const &obj ) const {
+	unsigned long long x = scramble( obj );
+	long long q = static_cast<long long>( x & mask );
+	unsigned long long r = x >> power;
+
+	if ( !get_bit( SLOT_OCCUPIED, q ) ) {
+		return false;
+	}
+
+	//Remainders within a run are sorted, so stop at the first one that is not smaller
+	long long s = find_run_start( q );
+
+	do {
+		unsigned long long stored = get_remainder( s );
+
+		if ( stored == r ) {
+			return true;
+		} else if ( stored > r ) {
+			return false;
+		}
+
+		s = (s + 1) & mask;
+	} while ( get_bit( SLOT_CONTINUATION, s ) );
+
+	return false;
+}
+
+//Mutators
+//Inserts the argument if it is not already in the set.
+//Throws overflow if every slot but one is in use; the spare slot ends every cluster
+template <typename Type>
+void Quotient_set<Type>::insert( Type const &obj ) {
+	if ( member( obj ) ) {
+		return;
+	}
+
+	if ( count >= array_size - 1 ) {
+		throw overflow();
+	}
+
+	unsigned long long x = scramble( obj );
+	long long q = static_cast<long long>( x & mask );
+	unsigned long long r = x >> power;
+
+	//The cluster that the new entry joins starts at or before its home slot
+	long long c = q;
+
+	while ( get_bit( SLOT_SHIFTED, c ) ) {
+		c = (c - 1) & mask;
+	}
+
+	long long n = decode( c );
+	unsigned long long home = (q - c) & mask;
+	long long i = n;
+
+	//Shift the larger entries up by one to open the sorted position
+	while ( i > 0 && (run_quotient[i - 1] > home || (run_quotient[i - 1] == home && run_remainder[i - 1] > r)) ) {
+		run_quotient[i] = run_quotient[i - 1];
+		run_remainder[i] = run_remainder[i - 1];
+		--i;
+	}
+
+	run_quotient[i] = home;
+	run_remainder[i] = r;
+
+	encode( c, n + 1 );
+	++count;
+}
+
+template <typename Type>
+bool Quotient_set<Type>::erase( Type const &obj ) {
+	if ( !member( obj ) ) {
+		return false;
+	}
+
+	unsigned long long x = scramble( obj );
+	long long q = static_cast<long long>( x & mask );
+	unsigned long long r = x >> power;
+	long long c = q;
+
+	while ( get_bit( SLOT_SHIFTED, c ) ) {
+		c = (c - 1) & mask;
+	}
+
+	long long n = decode( c );
+	unsigned long long home = (q - c) & mask;
+	long long j = 0;
+
+	for ( long long i = 0; i < n; ++i ) {
+		if ( run_quotient[i] != home || run_remainder[i] != r ) {
+			run_quotient[j] = run_quotient[i];
+			run_remainder[j] = run_remainder[i];
+			++j;
+		}
+	}
+
+	encode( c, j );
+	--count;
+
+	return true;
+}
+
+template <typename Type>
+void Quotient_set<Type>::clear() {
+	long long words = 3*((array_size + 63)/64);
+
+	for ( long long i = 0; i < words; ++i ) {
+		metadata[i] = 0;
+	}
+
+	count = 0;
+}
+
+#endif
@@ -0,0 +1,236 @@
+#ifndef QUOTIENT_SET_TESTER_H
+#define QUOTIENT_SET_TESTER_H
+
+#ifndef nullptr
+#define nullptr 0
+#endif
+
+#include "Exceptions.h"
+#include "Test.h"
+#include "Quotient_Set.h"
+#include "Hash_Functions.h"
+
+#include <iostream>
+#include <set>
+
+
+template <typename Type>
+class Quotient_set_tester:public test< Quotient_set<Type> > {
+	using test< Quotient_set<Type> >::object;
+	using test< Quotient_set<Type> >::command;
+
+	public:
+		Quotient_set_tester(Quotient_set<Type> *obj =
+0 ):test< Quotient_set<Type> >(obj){
+			//empty
+		}
+
+		void process();
+};
+
+template <typename Type>
+void Quotient_set_tester<Type>::process() {
+	if(command == "new"){
+		object = new Quotient_set<Type>();
+		std::cout << "Okay" << std::endl;
+	} else if(command == "new:"){
+		int n;
+		std::cin >> n;
+		object = new Quotient_set<Type>(n );
+		std::cout << "Okay" << std::endl;
+	} else if(command == "new!:"){
+		//The number of slots is out of range
+
+		int n;
+
+		std::cin >> n;
+
+		try {
+			object = new Quotient_set<Type>(n );
+			std::cout << "Failed Quotient_set(" << n << "): expecting to catch an exception but did not" << std::endl;
+		} catch(illegal_argument){
+			std::cout << "Okay" << std::endl;
+		} catch (...) {
+			std::cout << "Failed Quotient_set(" << n << "): expecting an illegal_argument exception but caught a different exception" << std::endl;
+		}
+	} else if(command == "size"){
+		//Check if the size equals the next integer read
+
+		long long expected_size;
+
+		std::cin >> expected_size;
+
+		long long actual_size = object->size();
+
+		if(actual_size == expected_size){
+			std::cout << "Okay" << std::endl;
+		} else {
+			std::cout << ": Failed size(): expecting the value '" << expected_size << "' but got '" << actual_size << "'" << std::endl;
+		}
+	} else if(command == "capacity"){
+		//Check if the capacity equals the next integer read
+
+		long long expected_capacity;
+
+		std::cin >> expected_capacity;
+
+		long long actual_capacity = object->capacity();
+
+		if(actual_capacity == expected_capacity){
+			std::cout << "Okay" << std::endl;
+		} else {
+			std::cout << ": Failed capacity(): expecting the value '" << expected_capacity << "' but got '" << actual_capacity << "'" << std::endl;
+		}
+	} else if(command == "empty"){
+		//Check if the empty status equals the next Boolean read
+
+		bool expected_empty;
+
+		std::cin >> expected_empty;
+
+		bool actual_empty = object->empty();
+
+		if(actual_empty == expected_empty){
+			std::cout << "Okay" << std::endl;
+		} else {
+			std::cout << ": Failed empty(): expecting the value '" << expected_empty << "' but got '" << actual_empty << "'" << std::endl;
+		}
+	} else if(command == "member"){
+		//Check if the element is in the object
+
+		Type n;
+		bool expected_member;
+
+		std::cin >> n;
+		std::cin >> expected_member;
+
+		bool actual_member = object->member(n );
+
+		if(actual_member == expected_member){
+			std::cout << "Okay" << std::endl;
+		} else {
+			std::cout << ": Failed member(" << n << "): expecting the value '" << expected_member << "' but got '" << actual_member << "'" << std::endl;
+		}
+	} else if(command == "insert"){
+		Type n;
+
+		std::cin >> n;
+
+		object->insert(n );
+		std::cout << "Okay" << std::endl;
+	} else if(command == "insert!"){
+		//Cannot insert as every slot but the spare one is used
+
+		Type n;
+
+		std::cin >> n;
+
+		try {
+			object->insert(n );
+			std::cout << "Failed insert(" << n << "): expecting to catch an exception but did not" << std::endl;
+		} catch(overflow){
+			std::cout << "Okay" << std::endl;
+		} catch (...) {
+			std::cout << "Failed insert(" << n << "): expecting an overflow exception but caught a different exception" << std::endl;
+		}
+	} else if(command == "erase"){
+		Type n;
+		bool expected_value;
+
+		std::cin >> n;
+		std::cin >> expected_value;
+
+		bool actual_value = object->erase(n );
+
+		if(actual_value == expected_value){
+			std::cout << "Okay" << std::endl;
+		} else {
+			std::cout << ": Failed erase(" << n << "): expecting the value '" << expected_value << "' but got '" << actual_value << "'" << std::endl;
+		}
+	} else if(command == "clear"){
+		object->clear();
+
+		std::cout << "Okay" << std::endl;
+	} else if(command == "reference"){
+		//Clear the object, then run n random inserts, erases and lookups, half of them inserts,
+		//on it and on a std::set, and check every result and the size after each operation. The
+		//keys are drawn from a pool of the given size, spread over the whole range of Type by the
+		//seed read. As inserts are twice as frequent as erases, about two thirds of the pool ends
+		//up in the set: a pool of 9/8 of the capacity keeps the load near 3/4, and one of twice
+		//the capacity keeps the set full up to its spare slot, as one long cluster. The nodes
+		//of the std::set are not recorded, as there can be more of them than the allocation
+		//table has room for
+
+		long long n;
+		long long pool;
+		unsigned long long seed;
+
+		std::cin >> n;
+		std::cin >> pool;
+		std::cin >> seed;
+
+		std::set<Type> reference;
+		long long failed = -1;
+
+		object->clear();
+
+		for(long long i = 0; i < n && failed < 0; ++i){
+			unsigned long long r = splitmix64(seed + 2*i );
+			Type key = static_cast<Type>(splitmix64(seed ^ static_cast<unsigned long long>(r % pool ) ) );
+			bool present = reference.count(key ) != 0;
+			int op = static_cast<int>(splitmix64(seed + 2*i + 1 ) % 4 );
+
+			if(op < 2){
+				if(!present && static_cast<long long>(reference.size() ) >= object->capacity() - 1){
+					try {
+						object->insert(key );
+						failed = i;
+					} catch(overflow){
+						//Expected: only the spare slot is left
+					}
+				} else {
+					object->insert(key );
+					ece250::allocation_table.stop_recording();
+					reference.insert(key );
+					ece250::allocation_table.start_recording();
+				}
+			} else if(op == 2){
+				if(object->erase(key ) != present){
+					failed = i;
+				}
+
+				ece250::allocation_table.stop_recording();
+				reference.erase(key );
+				ece250::allocation_table.start_recording();
+			} else if(object->member(key ) != present){
+				failed = i;
+			}
+
+			if(object->size() != static_cast<long long>(reference.size() )){
+				failed = i;
+			}
+		}
+
+		//Every key of the pool must still be found exactly when the reference has it
+		for(long long k = 0; k < pool && failed < 0; ++k){
+			Type key = static_cast<Type>(splitmix64(seed ^ static_cast<unsigned long long>(k ) ) );
+
+			if(object->member(key ) != (reference.count(key ) != 0)){
+				failed = n;
+			}
+		}
+
+		ece250::allocation_table.stop_recording();
+		reference.clear();
+		ece250::allocation_table.start_recording();
+
+		if(failed < 0){
+			std::cout << "Okay" << std::endl;
+		} else {
+			std::cout << ": Failed reference(" << n << ", " << pool << ", " << seed << "): the set and the reference differ after operation " << failed << std::endl;
+		}
+	} else {
+		std::cout << command << ": Command not found." << std::endl;
+	}
+}
+#endif
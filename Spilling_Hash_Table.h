@@ -0,0 +1,467 @@
+#ifndef SPILLING_HASH_TABLE_H
+#define SPILLING_HASH_TABLE_H
+
+#ifndef nullptr
+#define nullptr 0
+#endif
+
+#include "Exceptions.h"
+#include "Hash_Table.h"
+#include "Hash_Functions.h"
+#include "File_IO.h"
+
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+#include <fcntl.h>
+#include <unistd.h>
+
+//Set of keys that may outgrow memory, for deduplication and distinct counting (grace hash).
+//Keys are kept in an in-memory Hash_table until it holds memory_keys of them. The next new key
+//spills the table: from then on every key, starting with those in memory, is appended to one of
+//partitions files chosen by the high bits of its hash. Each file has a buffer of BUFFER_BYTES,
+//so the disk sees large sequential writes. finish() then reads the files back one at a time into
+//a Hash_table sized for the file. Equal keys always share a file, so each file is deduplicated on
+//its own; a file with more than memory_keys distinct keys is split again on the next hash bits.
+//
+//Keys are written as raw bytes, so Type has to be trivially copyable
+template <typename Type>
+class Spilling_hash_table {
+	static_assert( std::is_trivially_copyable<Type>::value, "Spilling_hash_table keys are written as raw bytes" );
+
+	private:
+		static const int BUFFER_BYTES = 1 << 18;	//Write buffer per partition file
+		static const int IO_SIZE = 1 << 20;			//Bytes per read() of a partition file
+		static const int BATCH = 16;				//Keys whose home bins are prefetched together
+
+		Hash_table<Type> table;
+		char *prefix;
+		char *file_name;
+		bin_index_t memory_keys;
+		int partitions;
+		int bits;					//log2( partitions ): hash bits used per level of partitioning
+		long long next_file;		//Number given to the next partition file
+		long long spilled_bytes;
+
+		//The open partition files while spilling, nullptr before the table spills
+		int *fd;
+		long long *file_id;
+		unsigned char *buffer;
+		int *buffered;
+
+		static unsigned long long hash( Type const & );
+
+		char const *name( long long );
+		void open_partitions( int );
+		void append( Type const &, int );
+		void close_partitions();
+		void spill();
+		template <typename Function>
+		bin_index_t process( long long, int, Function & );
+
+	public:
+		Spilling_hash_table( char const *, bin_index_t, int = 64 );
+		~Spilling_hash_table();
+
+		bool spilled() const;
+		long long bytes_spilled() const;
+
+		void insert( Type const & );
+		template <typename Function>
+		bin_index_t finish( Function );
+		bin_index_t finish();
+
+	private:
+		Spilling_hash_table( Spilling_hash_table const & );
+		Spilling_hash_table &operator=( Spilling_hash_table const & );
+};
+
+//Constructor
+//Partition files are named prefix.<number> and removed once read. Throws illegal_argument unless
+//memory_keys >= 1 and partitions is a power of two from 2 to 2^16
+template <typename Type>
+Spilling_hash_table<Type>::Spilling_hash_table( char const *p, bin_index_t m, int n ):
+table( 5 ),
+prefix( new char[std::strlen( p ) + 1] ),
+file_name( new char[std::strlen( p ) + 24] ),
+memory_keys( m ),
+partitions( n ),
+bits( 0 ),
+next_file( 0 ),
+spilled_bytes( 0 ),
+fd( nullptr ),
+file_id( nullptr ),
+buffer( nullptr ),
+buffered( nullptr ) {
+	std::strcpy( prefix, p );
+
+	while ( (1 << bits) < partitions && bits < 16 ) {
+		++bits;
+	}
+
+	if ( memory_keys < 1 || partitions < 2 || (1 << bits) != partitions ) {
+		delete[] prefix;
+		delete[] file_name;
+		throw illegal_argument();
+	}
+}
+
+//Destructor
+//Removes the partition files of an unfinished spill
+template <typename Type>
+Spilling_hash_table<Type>::~Spilling_hash_table() {
+	if ( fd != nullptr && file_id != nullptr ) {
+		for ( int i = 0; i < partitions; ++i ) {
+			close( fd[i] );
+			unlink( name( file_id[i] ) );
+		}
+
+		delete[] fd;
+		delete[] file_id;
+		delete[] buffer;
+		delete[] buffered;
+	}
+
+	delete[] prefix;
+	delete[] file_name;
+}
+
+//Equal keys must reach the same file, and key_bits() gives equal keys the same value
+template <typename Type>
+unsigned long long Spilling_hash_table<Type>::hash( Type const &obj ) {
+	return splitmix64( key_bits( obj ) );
+}
+
+template <typename Type>
+char const *Spilling_hash_table<Type>::name( long long id ) {
+	std::sprintf( file_name, "%s.%lld", prefix, id );
+
+	return file_name;
+}
+
+//Creates the partition files for the given level of partitioning
+template <typename Type>
+void Spilling_hash_table<Type>::open_partitions( int level ) {
+	if ( bits*(level + 1) > 64 ) {
+		//Only possible with a memory budget far below the number of keys sharing a 64-bit hash
+		throw overflow();
+	}
+
+	fd = new int[partitions];
+	file_id = new long long[partitions];
+	buffer = new unsigned char[static_cast<long long>( partitions )*BUFFER_BYTES];
+	buffered = new int[partitions];
+
+	for ( int i = 0; i < partitions; ++i ) {
+		fd[i] = -1;
+	}
+
+	for ( int i = 0; i < partitions; ++i ) {
+		file_id[i] = next_file++;
+		buffered[i] = 0;
+		fd[i] = open( name( file_id[i] ), O_RDWR | O_CREAT | O_TRUNC, 0644 );
+
+		if ( fd[i] < 0 ) {
+			for ( int j = 0; j < i; ++j ) {
+				unlink( name( file_id[j] ) );
+			}
+
+			delete[] file_id;
+			file_id = nullptr;
+			close_partitions();
+			throw io_error();
+		}
+	}
+}
+
+//Writes out the buffers and closes the files, which stay on disk
+template <typename Type>
+void Spilling_hash_table<Type>::close_partitions() {
+	bool ok = true;
+
+	for ( int i = 0; i < partitions; ++i ) {
+		if ( fd[i] >= 0 ) {
+			if ( ok && buffered[i] > 0 ) {
+				try {
+					write_fully( fd[i], buffer + static_cast<long long>( i )*BUFFER_BYTES, buffered[i] );
+				} catch ( io_error ) {
+					ok = false;
+				}
+			}
+
+			close( fd[i] );
+		}
+	}
+
+	delete[] fd;
+	delete[] buffer;
+	delete[] buffered;
+	fd = nullptr;
+	buffer = nullptr;
+	buffered = nullptr;
+
+	if ( !ok ) {
+		throw io_error();
+	}
+}
+
+//Buffers obj for the partition file picked by the hash bits of the given level: the top bits
+//for level 0, the ones below them for level 1, and so on
+template <typename Type>
+void Spilling_hash_table<Type>::append( Type const &obj, int level ) {
+	int i = static_cast<int>( (hash( obj ) << (bits*level)) >> (64 - bits) );
+	unsigned char *b = buffer + static_cast<long long>( i )*BUFFER_BYTES;
+
+	if ( buffered[i] + static_cast<int>( sizeof( Type ) ) > BUFFER_BYTES ) {
+		write_fully( fd[i], b, buffered[i] );
+		buffered[i] = 0;
+	}
+
+	std::memcpy( b + buffered[i], &obj, sizeof( Type ) );
+	buffered[i] += sizeof( Type );
+	spilled_bytes += sizeof( Type );
+}
+
+//Moves the keys in memory to the partition files and frees the bins
+template <typename Type>
+void Spilling_hash_table<Type>::spill() {
+	open_partitions( 0 );
+
+	for ( bin_index_t i = 0; i < table.array_size; ++i ) {
+		if ( table.live( i ) ) {
+			append( table.array[i], 0 );
+		}
+	}
+
+	table = Hash_table<Type>( 5 );
+}
+
+//Accessors
+template <typename Type>
+bool Spilling_hash_table<Type>::spilled() const {
+	return (fd != nullptr);
+}
+
+//Returns the bytes written to partition files so far, including by finish()
+template <typename Type>
+long long Spilling_hash_table<Type>::bytes_spilled() const {
+	return spilled_bytes;
+}
+
+//Mutators
+template <typename Type>
+void Spilling_hash_table<Type>::insert( Type const &obj ) {
+	if ( fd == nullptr ) {
+		if ( table.size() < memory_keys ) {
+			//Grow before the load factor passes 3/4, but no further than the budget needs
+			if ( 4*(table.size() + 1) > 3*table.capacity() ) {
+				bin_index_t n = 2*(table.size() + 1);
+				table.reserve( n < memory_keys ? n : memory_keys );
+			}
+
+			table.insert( obj );
+			return;
+		}
+
+		if ( table.member( obj ) ) {
+			return;
+		}
+
+		spill();
+	}
+
+	append( obj, 0 );
+}
+
+//Calls f once for every distinct key inserted and returns the number of distinct keys, then
+//empties the table for reuse. Each partition file is read sequentially into a Hash_table
+//presized for it, with the home bins of each batch of keys prefetched, and then removed.
+//Throws io_error if a file cannot be written or read
+template <typename Type>
+template <typename Function>
+bin_index_t Spilling_hash_table<Type>::finish( Function f ) {
+	bin_index_t distinct = 0;
+
+	if ( fd == nullptr ) {
+		for ( bin_index_t i = 0; i < table.array_size; ++i ) {
+			if ( table.live( i ) ) {
+				f( table.array[i] );
+				++distinct;
+			}
+		}
+
+		table = Hash_table<Type>( 5 );
+
+		return distinct;
+	}
+
+	long long *ids = file_id;
+	file_id = nullptr;
+
+	try {
+		close_partitions();
+
+		for ( int i = 0; i < partitions; ++i ) {
+			distinct += process( ids[i], 1, f );
+		}
+	} catch ( ... ) {
+		for ( int i = 0; i < partitions; ++i ) {
+			unlink( name( ids[i] ) );
+		}
+
+		delete[] ids;
+		throw;
+	}
+
+	delete[] ids;
+
+	return distinct;
+}
+
+template <typename Type>
+bin_index_t Spilling_hash_table<Type>::finish() {
+	struct {
+		void operator()( Type const & ) const {
+			//count only
+		}
+	} ignore;
+
+	return finish( ignore );
+}
+
+//Deduplicates one partition file, at the given level of partitioning, and removes it.
+//A file with more than memory_keys distinct keys is split into partitions files on the
+//next bits of the hash, and each of those is processed in turn
+template <typename Type>
+template <typename Function>
+bin_index_t Spilling_hash_table<Type>::process( long long id, int level, Function &f ) {
+	int in = open( name( id ), O_RDONLY );
+
+	if ( in < 0 ) {
+		throw io_error();
+	}
+
+	long long keys = lseek( in, 0, SEEK_END )/sizeof( Type );
+
+	lseek( in, 0, SEEK_SET );
+
+	const long long per_read = IO_SIZE/sizeof( Type );
+	unsigned char *data = new unsigned char[per_read*sizeof( Type )];
+	Hash_table<Type> part( 5 );
+	bool fits = true;
+
+	part.reserve( keys < memory_keys ? keys : memory_keys );
+
+	try {
+		Type batch[BATCH];
+
+		for ( long long done = 0; done < keys && fits; ) {
+			long long size = (keys - done < per_read) ? keys - done : per_read;
+
+			if ( read_fully( in, data, size*sizeof( Type ) ) != static_cast<long long>( size*sizeof( Type ) ) ) {
+				throw io_error();
+			}
+
+			for ( long long first = 0; first < size && fits; first += BATCH ) {
+				int n = (size - first < BATCH) ? size - first : BATCH;
+
+				for ( int i = 0; i < n; ++i ) {
+					std::memcpy( &batch[i], data + (first + i)*sizeof( Type ), sizeof( Type ) );
+					part.prefetch( batch[i] );
+				}
+
+				for ( int i = 0; i < n; ++i ) {
+					if ( part.size() >= memory_keys && !part.member( batch[i] ) ) {
+						fits = false;
+						break;
+					}
+
+					part.insert( batch[i] );
+				}
+			}
+
+			done += size;
+		}
+
+		bin_index_t distinct = 0;
+
+		if ( fits ) {
+			for ( bin_index_t i = 0; i < part.array_size; ++i ) {
+				if ( part.live( i ) ) {
+					f( part.array[i] );
+					++distinct;
+				}
+			}
+		} else {
+			//Too many keys share this file: split it on the next hash bits, reading it again from the start
+			part = Hash_table<Type>( 5 );
+			open_partitions( level );
+
+			long long *ids = file_id;
+			file_id = nullptr;
+
+			try {
+				lseek( in, 0, SEEK_SET );
+
+				for ( long long done = 0; done < keys; ) {
+					long long size = (keys - done < per_read) ? keys - done : per_read;
+
+					if ( read_fully( in, data, size*sizeof( Type ) ) != static_cast<long long>( size*sizeof( Type ) ) ) {
+						throw io_error();
+					}
+
+					for ( long long i = 0; i < size; ++i ) {
+						Type key;
+						std::memcpy( &key, data + i*sizeof( Type ), sizeof( Type ) );
+						append( key, level );
+					}
+
+					done += size;
+				}
+
+				close_partitions();
+				close( in );
+				in = -1;
+				unlink( name( id ) );
+
+				for ( int i = 0; i < partitions; ++i ) {
+					distinct += process( ids[i], level + 1, f );
+					ids[i] = -1;
+				}
+			} catch ( ... ) {
+				if ( fd != nullptr ) {
+					close_partitions();
+				}
+
+				for ( int i = 0; i < partitions; ++i ) {
+					if ( ids[i] >= 0 ) {
+						unlink( name( ids[i] ) );
+					}
+				}
+
+				delete[] ids;
+				throw;
+			}
+
+			delete[] ids;
+		}
+
+		if ( in >= 0 ) {
+			close( in );
+			unlink( name( id ) );
+		}
+
+		delete[] data;
+
+		return distinct;
+	} catch ( ... ) {
+		if ( in >= 0 ) {
+			close( in );
+		}
+
+		delete[] data;
+		throw;
+	}
+}
+
+#endif
@@ -0,0 +1,202 @@
+#ifndef SPILLING_HASH_TABLE_TESTER_H
+#define SPILLING_HASH_TABLE_TESTER_H
+
+#ifndef nullptr
+#define nullptr 0
+#endif
+
+#include "Exceptions.h"
+#include "Test.h"
+#include "Spilling_Hash_Table.h"
+
+#include <iostream>
+#include <string>
+#include <cstring>
+#include <dirent.h>
+
+
+template <typename Type>
+class Spilling_hash_table_tester:public test< Spilling_hash_table<Type> > {
+	using test< Spilling_hash_table<Type> >::object;
+	using test< Spilling_hash_table<Type> >::command;
+
+	public:
+		Spilling_hash_table_tester(Spilling_hash_table<Type> *obj =
+0 ):test< Spilling_hash_table<Type> >(obj){
+			//empty
+		}
+
+		void process();
+};
+
+template <typename Type>
+void Spilling_hash_table_tester<Type>::process() {
+	if(command == "new:"){
+		std::string prefix;
+		bin_index_t memory_keys;
+		int partitions;
+
+		std::cin >> prefix;
+		std::cin >> memory_keys;
+		std::cin >> partitions;
+
+		object = new Spilling_hash_table<Type>(prefix.c_str(), memory_keys, partitions );
+		std::cout << "Okay" << std::endl;
+	} else if(command == "new!:"){
+		//The memory budget or the number of partitions is out of range
+
+		std::string prefix;
+		bin_index_t memory_keys;
+		int partitions;
+
+		std::cin >> prefix;
+		std::cin >> memory_keys;
+		std::cin >> partitions;
+
+		try {
+			object = new Spilling_hash_table<Type>(prefix.c_str(), memory_keys, partitions );
+			std::cout << "Failed Spilling_hash_table(" << memory_keys << ", " << partitions << "): expecting to catch an exception but did not" << std::endl;
+		} catch(illegal_argument){
+			std::cout << "Okay" << std::endl;
+		} catch (...) {
+			std::cout << "Failed Spilling_hash_table(" << memory_keys << ", " << partitions << "): expecting an illegal_argument exception but caught a different exception" << std::endl;
+		}
+	} else if(command == "insert"){
+		Type n;
+
+		std::cin >> n;
+
+		object->insert(n );
+		std::cout << "Okay" << std::endl;
+	} else if(command == "insert_range"){
+		//Insert a, a + 1, ..., b - 1
+
+		Type a;
+		Type b;
+
+		std::cin >> a;
+		std::cin >> b;
+
+		for(Type n = a; n < b; ++n){
+			object->insert(n );
+		}
+
+		std::cout << "Okay" << std::endl;
+	} else if(command == "spilled"){
+		//Check if the spilled status equals the next Boolean read
+
+		bool expected_spilled;
+
+		std::cin >> expected_spilled;
+
+		bool actual_spilled = object->spilled();
+
+		if(actual_spilled == expected_spilled){
+			std::cout << "Okay" << std::endl;
+		} else {
+			std::cout << ": Failed spilled(): expecting the value '" << expected_spilled << "' but got '" << actual_spilled << "'" << std::endl;
+		}
+	} else if(command == "bytes_spilled"){
+		//Check if the bytes written to partition files equal the next integer read
+
+		long long expected_bytes;
+
+		std::cin >> expected_bytes;
+
+		long long actual_bytes = object->bytes_spilled();
+
+		if(actual_bytes == expected_bytes){
+			std::cout << "Okay" << std::endl;
+		} else {
+			std::cout << ": Failed bytes_spilled(): expecting the value '" << expected_bytes << "' but got '" << actual_bytes << "'" << std::endl;
+		}
+	} else if(command == "finish"){
+		//Check the number of distinct keys returned
+
+		bin_index_t expected_distinct;
+
+		std::cin >> expected_distinct;
+
+		bin_index_t actual_distinct = object->finish();
+
+		if(actual_distinct == expected_distinct){
+			std::cout << "Okay" << std::endl;
+		} else {
+			std::cout << ": Failed finish(): expecting the value '" << expected_distinct << "' but got '" << actual_distinct << "'" << std::endl;
+		}
+	} else if(command == "finish_range"){
+		//Check that the distinct keys passed to the function are a, a + 1, ..., b - 1,
+		//each passed exactly once
+
+		Type a;
+		Type b;
+
+		std::cin >> a;
+		std::cin >> b;
+
+		long long span = static_cast<long long>(b - a );
+		long long *calls = new long long[span > 0 ? span : 1];
+		long long outside = 0;
+
+		for(long long i = 0; i < span; ++i){
+			calls[i] = 0;
+		}
+
+		bin_index_t actual_distinct = object->finish([&](Type const &n ){
+			if(n < a || n >= b){
+				++outside;
+			} else {
+				++calls[static_cast<long long>(n - a )];
+			}
+		} );
+
+		long long i = 0;
+
+		while(i < span && calls[i] == 1){
+			++i;
+		}
+
+		if(outside == 0 && i == span && actual_distinct == span){
+			std::cout << "Okay" << std::endl;
+		} else if(i < span){
+			std::cout << ": Failed finish(): expecting the key '" << (a + static_cast<Type>(i ) ) << "' once but got it " << calls[i] << " times" << std::endl;
+		} else {
+			std::cout << ": Failed finish(): expecting " << span << " distinct keys but got " << actual_distinct << ", " << outside << " of them out of range" << std::endl;
+		}
+
+		delete[] calls;
+	} else if(command == "files:"){
+		//Check how many partition files named prefix.<number> exist
+
+		std::string prefix;
+		int expected_files;
+
+		std::cin >> prefix;
+		std::cin >> expected_files;
+
+		std::string::size_type slash = prefix.rfind('/' );
+		std::string directory = (slash == std::string::npos) ? "." : prefix.substr(0, slash + 1 );
+		std::string base = ((slash == std::string::npos) ? prefix : prefix.substr(slash + 1 )) + ".";
+		int actual_files = 0;
+		DIR *dir = opendir(directory.c_str() );
+
+		if(dir != nullptr){
+			for(struct dirent *entry = readdir(dir ); entry != nullptr; entry = readdir(dir )){
+				if(std::strncmp(entry->d_name, base.c_str(), base.size() ) == 0){
+					++actual_files;
+				}
+			}
+
+			closedir(dir );
+		}
+
+		if(actual_files == expected_files){
+			std::cout << "Okay" << std::endl;
+		} else {
+			std::cout << ": Failed files(" << prefix << "): expecting the value '" << expected_files << "' but got '" << actual_files << "'" << std::endl;
+		}
+	} else {
+		std::cout << command << ": Command not found." << std::endl;
+	}
+}
+#endif